@@ -0,0 +1,519 @@
+/*
+ *  aspects.cpp
+ *  ===========
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of aspect search functions.
+ *
+ *  Uses C++11 threads.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <cstddef>
+#include <cmath>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <exception>
+#include <system_error>
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "element_tables.h"
+#include "body_time_series.h"
+#include "aspects.h"
+
+using std::fabs;
+using std::sqrt;
+using std::atan2;
+
+using namespace astro;
+
+
+/*
+ *  Local types, constants and function prototypes
+ */
+
+namespace {
+
+//  Separations, in degrees, at which aspects occur, measured as the
+//  longitude of the first body less that of the second in the range
+//  0 to 360
+
+const double aspect_targets[] = {0, 60, 90, 120, 180, 240, 270, 300, 360};
+const size_t num_aspect_targets = sizeof(aspect_targets) /
+                                  sizeof(aspect_targets[0]);
+
+//  Separation, in degrees, within which the search takes short steps
+//  and checks for crossings, rather than stepping safely past
+
+const double near_separation = 1;
+
+//  Length, in days, of the periods into which the search is divided
+//  between threads
+
+const double chunk_days = 3652.5;
+
+//  Safety factor applied to longitude rate bounds, to allow for the
+//  slow drift of the orbital elements
+
+const double rate_bound_margin = 1.1;
+
+//  Greatest rate of change of the Moon's geocentric ecliptic
+//  longitude, in degrees per day, found by sampling its motion over
+//  1800 to 2100. Its perturbations make a bound from its orbital
+//  elements alone unreliable.
+
+const double moon_longitude_rate = 15.4;
+
+//  Tolerance, in days, to which aspect times are refined, and maximum
+//  number of root finding iterations
+
+const double aspect_tolerance = 1e-6;
+const int max_refine_iterations = 100;
+
+typedef std::unique_ptr<const BodyTimeSeries> SeriesPtr;
+
+struct AspectJob {
+    AspectJob(const SeriesPtr * s, const double * bounds,
+              const size_t * first, const size_t * second,
+              const size_t pairs, const double start, const double end,
+              const size_t chunks) :
+        series(s), rate_bounds(bounds), pair_first(first),
+        pair_second(second), num_pairs(pairs), start_jd(start),
+        end_jd(end), num_chunks(chunks), next_item(0), mutex() {}
+    AspectJob(const AspectJob&) = delete;
+    AspectJob& operator=(const AspectJob&) = delete;
+
+    const SeriesPtr * series;
+    const double * rate_bounds;
+    const size_t * pair_first;
+    const size_t * pair_second;
+    size_t num_pairs;
+    double start_jd;
+    double end_jd;
+    size_t num_chunks;
+    size_t next_item;
+    std::mutex mutex;
+};
+
+//  The events found by one thread, or the exception which stopped it
+
+struct ThreadResult {
+    ThreadResult() :
+        events(), error() {}
+
+    std::vector<AspectEvent> events;
+    std::exception_ptr error;
+};
+
+void aspect_thread(AspectJob& job, ThreadResult& result);
+void run_aspect_search(AspectJob& job, std::vector<AspectEvent>& found);
+bool next_item(AspectJob& job, size_t& item);
+void search_pair(const BodyTimeSeries& first, const BodyTimeSeries& second,
+                 const double rate_bound, const double start_jd,
+                 const double end_jd, std::vector<AspectEvent>& events);
+double separation(const BodyTimeSeries& first,
+                  const BodyTimeSeries& second,
+                  const double jdate, double& rate);
+double nearest_target(const double sep);
+double refine_aspect(const BodyTimeSeries& first,
+                     const BodyTimeSeries& second, const double target,
+                     double t0, double f0, double t1);
+double offset_from(const double sep, const double target);
+double perihelion_speed(const OrbElem& j2000_oes, const double mean_motion);
+bool event_before(const AspectEvent& a, const AspectEvent& b);
+
+}           //  namespace
+
+
+/*
+ *  Finds the times at which each pair of the supplied bodies are in
+ *  aspect, i.e. at which the difference between their geocentric
+ *  ecliptic longitudes is 0, 60, 90, 120 or 180 degrees, between the
+ *  supplied Julian dates.
+ *
+ *  The events are appended to the supplied vector, and the appended
+ *  events are sorted by time. The work is divided between the
+ *  specified number of threads, including the calling thread, and
+ *  the results are identical for any number of threads.
+ *
+ *  For each pair, the search steps through time using the sum of
+ *  the bodies' longitude_rate_bound()s, so that while the separation
+ *  is more than a degree from any aspect, each step is as long as
+ *  possible without being able to reach one. Near an aspect, short
+ *  steps are taken and each crossing is refined by Newton's method,
+ *  using analytic longitude rates, to within about 0.1 seconds. An
+ *  aspect which is reached and left within a single short step, for
+ *  instance while one of the bodies is stationary, may be missed.
+ */
+
+void astro::find_aspects(const BodyId * bodies, const size_t num_bodies,
+                         const double start_jd, const double end_jd,
+                         std::vector<AspectEvent>& events,
+                         const int num_threads) {
+    assert(num_threads > 0);
+    assert(end_jd >= start_jd);
+
+    //  Set up the job, with a time series for each body, and one item
+    //  of work for each period of chunk_days for each pair.
+
+    std::vector<SeriesPtr> series(num_bodies);
+    std::vector<double> rate_bounds(num_bodies);
+    for ( size_t i = 0; i < num_bodies; ++i ) {
+        series[i].reset(new BodyTimeSeries(bodies[i]));
+        rate_bounds[i] = longitude_rate_bound(bodies[i]);
+    }
+
+    std::vector<size_t> pair_first, pair_second;
+    for ( size_t i = 0; i < num_bodies; ++i ) {
+        for ( size_t j = i + 1; j < num_bodies; ++j ) {
+            pair_first.push_back(i);
+            pair_second.push_back(j);
+        }
+    }
+
+    const bool have_pairs = !pair_first.empty();
+
+    AspectJob job(have_pairs ? &series[0] : 0,
+                  have_pairs ? &rate_bounds[0] : 0,
+                  have_pairs ? &pair_first[0] : 0,
+                  have_pairs ? &pair_second[0] : 0,
+                  pair_first.size(), start_jd, end_jd,
+                  static_cast<size_t>((end_jd - start_jd) / chunk_days) + 1);
+
+    //  Start the additional threads, and have the calling thread
+    //  take its share of the work. Each thread collects its events
+    //  separately, and they are merged once all have finished. Room
+    //  for the threads is reserved first, so that once a thread has
+    //  started, storing it cannot throw.
+
+    std::vector<ThreadResult> results(num_threads);
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+
+    try {
+        for ( int i = 1; i < num_threads; ++i ) {
+            threads.push_back(std::thread(aspect_thread, std::ref(job),
+                                          std::ref(results[i])));
+        }
+    } catch(std::system_error&) {
+    }
+
+    aspect_thread(job, results[0]);
+
+    for ( size_t i = 0; i < threads.size(); ++i ) {
+        threads[i].join();
+    }
+
+    const size_t first_event = events.size();
+    for ( size_t i = 0; i < results.size(); ++i ) {
+        if ( results[i].error ) {
+            events.resize(first_event);
+            std::rethrow_exception(results[i].error);
+        }
+        events.insert(events.end(), results[i].events.begin(),
+                      results[i].events.end());
+    }
+
+    std::sort(events.begin() + first_event, events.end(), event_before);
+}
+
+
+/*
+ *  Returns an upper bound on the magnitude of the rate of change of
+ *  the geocentric ecliptic longitude of the supplied body, in
+ *  degrees per day.
+ *
+ *  This is the sum of the perihelion speeds of the body and the
+ *  Earth, divided by the least possible distance between them, with
+ *  a margin for the drift of the orbital elements. For the Moon, it
+ *  is the greatest rate found by sampling, with the same margin.
+ */
+
+double astro::longitude_rate_bound(const BodyId body) {
+    assert(body >= BODY_SUN && body < NUM_BODIES);
+
+    if ( body == BODY_MOON ) {
+        return moon_longitude_rate * rate_bound_margin;
+    }
+
+    const OrbElem& eoes = EARTH_DEGREES.j2000;
+    const double earth_speed = perihelion_speed(eoes,
+            radians(EARTH_DEGREES.century.ml) / JDAYS_PER_CENT);
+    const double earth_near = eoes.sma * (1 - eoes.ecc);
+    const double earth_far = eoes.sma * (1 + eoes.ecc);
+
+    double speed = earth_speed;
+    double min_distance = earth_near;
+
+    if ( body != BODY_SUN ) {
+        const BodyElements& els = MAJOR_BODY_DEGREES[body];
+        const OrbElem& oes = els.j2000;
+        const double near = oes.sma * (1 - oes.ecc);
+        const double far = oes.sma * (1 + oes.ecc);
+
+        speed += perihelion_speed(oes,
+                radians(els.century.ml) / JDAYS_PER_CENT);
+        min_distance = near > earth_far ? near - earth_far :
+                                          earth_near - far;
+    }
+
+    assert(min_distance > 0);
+
+    return degrees(speed / min_distance) * rate_bound_margin;
+}
+
+
+namespace {
+
+/*
+ *  Thread function, which searches items of work until none remain,
+ *  and stores the events found, or the exception which stopped the
+ *  search, in (and modifies) the supplied result.
+ */
+
+void aspect_thread(AspectJob& job, ThreadResult& result) {
+    try {
+        run_aspect_search(job, result.events);
+    } catch(...) {
+        result.error = std::current_exception();
+    }
+}
+
+
+/*
+ *  Searches items of work until none remain, and appends the events
+ *  found to the supplied vector.
+ */
+
+void run_aspect_search(AspectJob& job, std::vector<AspectEvent>& found) {
+    size_t item;
+
+    while ( next_item(job, item) ) {
+        const size_t pair = item / job.num_chunks;
+        const size_t chunk = item % job.num_chunks;
+        const size_t a = job.pair_first[pair];
+        const size_t b = job.pair_second[pair];
+
+        const double t0 = job.start_jd + chunk * chunk_days;
+        const double t1 = chunk + 1 == job.num_chunks ?
+                          job.end_jd : t0 + chunk_days;
+
+        search_pair(*job.series[a], *job.series[b],
+                    job.rate_bounds[a] + job.rate_bounds[b],
+                    t0, t1, found);
+    }
+}
+
+
+/*
+ *  Claims the next item of work, and stores its index in (and
+ *  modifies) item.
+ *
+ *  Returns false if there are no items remaining.
+ */
+
+bool next_item(AspectJob& job, size_t& item) {
+    std::lock_guard<std::mutex> lock(job.mutex);
+
+    item = job.next_item;
+    const bool found = item < job.num_pairs * job.num_chunks;
+    if ( found ) {
+        ++job.next_item;
+    }
+
+    return found;
+}
+
+
+/*
+ *  Searches for aspects between a pair of bodies between the
+ *  supplied times, and appends them to the supplied vector.
+ *
+ *  rate_bound is the maximum rate, in degrees per day, at which the
+ *  separation of the bodies can change.
+ */
+
+void search_pair(const BodyTimeSeries& first, const BodyTimeSeries& second,
+                 const double rate_bound, const double start_jd,
+                 const double end_jd, std::vector<AspectEvent>& events) {
+    const double short_step = near_separation / rate_bound;
+
+    double t0 = start_jd;
+    double rate;
+    double sep0 = separation(first, second, t0, rate);
+
+    while ( t0 < end_jd ) {
+        const double target = nearest_target(sep0);
+        const double distance = fabs(sep0 - target);
+
+        //  Far from an aspect, step as far as the separation can
+        //  change without reaching one, and don't check for crossings
+
+        if ( distance >= near_separation ) {
+            t0 += distance / rate_bound;
+            if ( t0 < end_jd ) {
+                sep0 = separation(first, second, t0, rate);
+            }
+            continue;
+        }
+
+        //  Near an aspect, take a short step and check whether the
+        //  separation has crossed it
+
+        double t1 = t0 + short_step;
+        if ( t1 > end_jd ) {
+            t1 = end_jd;
+        }
+        const double sep1 = separation(first, second, t1, rate);
+
+        const double f0 = offset_from(sep0, target);
+        const double f1 = offset_from(sep1, target);
+        if ( (f0 < 0) != (f1 < 0) ) {
+            AspectEvent event;
+            event.jdate = refine_aspect(first, second, target, t0, f0, t1);
+            event.first = first.body();
+            event.second = second.body();
+            event.aspect = target <= 180 ? target : 360 - target;
+            events.push_back(event);
+        }
+
+        t0 = t1;
+        sep0 = sep1;
+    }
+}
+
+
+/*
+ *  Returns the difference between the geocentric ecliptic longitudes
+ *  of the first and second bodies at the supplied time, in degrees
+ *  in the range 0 to 360, and stores its rate of change, in degrees
+ *  per day, in (and modifies) rate.
+ */
+
+double separation(const BodyTimeSeries& first,
+                  const BodyTimeSeries& second,
+                  const double jdate, double& rate) {
+    RectCoords p1, v1, p2, v2;
+    first.geo_ecl_state(jdate, p1, v1);
+    second.geo_ecl_state(jdate, p2, v2);
+
+    const double lon1 = atan2(p1.y, p1.x);
+    const double lon2 = atan2(p2.y, p2.x);
+    const double rate1 = (p1.x * v1.y - p1.y * v1.x) /
+                         (p1.x * p1.x + p1.y * p1.y);
+    const double rate2 = (p2.x * v2.y - p2.y * v2.x) /
+                         (p2.x * p2.x + p2.y * p2.y);
+
+    rate = degrees(rate1 - rate2);
+    return normalize_degrees(degrees(lon1 - lon2));
+}
+
+
+/*
+ *  Returns the aspect target nearest to the supplied separation.
+ */
+
+double nearest_target(const double sep) {
+    double nearest = aspect_targets[0];
+    for ( size_t i = 1; i < num_aspect_targets; ++i ) {
+        if ( fabs(sep - aspect_targets[i]) < fabs(sep - nearest) ) {
+            nearest = aspect_targets[i];
+        }
+    }
+    return nearest;
+}
+
+
+/*
+ *  Returns the amount, in degrees in the range -180 to 180, by which
+ *  the supplied separation is past the supplied target.
+ */
+
+double offset_from(const double sep, const double target) {
+    const double d = normalize_degrees(sep - target);
+    return d > 180 ? d - 360 : d;
+}
+
+
+/*
+ *  Returns the time between t0 and t1 at which the separation of
+ *  the bodies equals the target, given that it is f0 past the target
+ *  at t0, and on the other side of it at t1.
+ *
+ *  Uses Newton's method with the analytic rate of change of the
+ *  separation. Steps falling outside the bracketing interval, which
+ *  is narrowed at each iteration, are replaced by bisection.
+ */
+
+double refine_aspect(const BodyTimeSeries& first,
+                     const BodyTimeSeries& second, const double target,
+                     double t0, double f0, double t1) {
+    double t = (t0 + t1) / 2;
+
+    for ( int i = 0; i < max_refine_iterations; ++i ) {
+        double rate;
+        const double f = offset_from(separation(first, second, t, rate),
+                                     target);
+        if ( f == 0 ) {
+            return t;
+        }
+
+        if ( (f < 0) == (f0 < 0) ) {
+            t0 = t;
+            f0 = f;
+        } else {
+            t1 = t;
+        }
+
+        double next = (t0 + t1) / 2;
+        if ( rate != 0 && t - f / rate > t0 && t - f / rate < t1 ) {
+            next = t - f / rate;
+        }
+
+        if ( fabs(next - t) < aspect_tolerance ) {
+            return next;
+        }
+        t = next;
+    }
+
+    return t;
+}
+
+
+/*
+ *  Returns the speed, in AU per day, of a body at perihelion, given
+ *  its orbital elements and its mean motion in radians per day.
+ */
+
+double perihelion_speed(const OrbElem& j2000_oes, const double mean_motion) {
+    return fabs(mean_motion) * j2000_oes.sma *
+           sqrt((1 + j2000_oes.ecc) / (1 - j2000_oes.ecc));
+}
+
+
+/*
+ *  Orders aspect events by time, and then by bodies and aspect so
+ *  that the order does not depend on the order in which they were
+ *  found.
+ */
+
+bool event_before(const AspectEvent& a, const AspectEvent& b) {
+    if ( a.jdate != b.jdate ) {
+        return a.jdate < b.jdate;
+    } else if ( a.first != b.first ) {
+        return a.first < b.first;
+    } else if ( a.second != b.second ) {
+        return a.second < b.second;
+    }
+    return a.aspect < b.aspect;
+}
+
+}           //  namespace
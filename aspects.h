@@ -0,0 +1,41 @@
+/*
+ *  aspects.h
+ *  =========
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to aspect search functions.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_ASPECTS_H
+#define PG_ASTRO_ASPECTS_H
+
+#include <cstddef>
+#include <vector>
+#include "astro_common_types.h"
+
+namespace astro {
+
+struct AspectEvent {
+    double jdate;           // Julian date of the exact aspect
+    BodyId first;
+    BodyId second;
+    double aspect;          // Separation, in degrees, of 0, 60, 90,
+                            // 120 or 180
+
+    AspectEvent() :
+        jdate(0), first(BODY_SUN), second(BODY_SUN), aspect(0) {}
+};
+
+void find_aspects(const BodyId * bodies, const size_t num_bodies,
+                  const double start_jd, const double end_jd,
+                  std::vector<AspectEvent>& events, const int num_threads);
+double longitude_rate_bound(const BodyId body);
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_ASPECTS_H
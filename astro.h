@@ -47,10 +47,25 @@
 
 #include "astro_common_types.h"
 #include "astrofunc.h"
+#include "julian_date.h"
 #include "planet.h"
+#include "element_tables.h"
 #include "major_body.h"
 #include "planets.h"
 #include "moon.h"
+#include "solar_system.h"
+#include "orbit_rotation.h"
+#include "body_state.h"
+#include "observer.h"
+#include "sidereal.h"
+#include "rise_set.h"
+#include "body_time_series.h"
+#include "chebyshev.h"
+#include "ephemeris_file.h"
+#include "ephemeris_generator.h"
+#include "zodiac.h"
+#include "events.h"
+#include "aspects.h"
 #include "planet_func.h"
 
 #endif          // PG_ASTRO_H
@@ -16,6 +16,25 @@
 
 namespace astro {
 
+/*
+ *  Identifies the bodies for which positions are reported, in the
+ *  order in which show_planet_positions() outputs them.
+ */
+
+enum BodyId {
+    BODY_SUN,
+    BODY_MERCURY,
+    BODY_VENUS,
+    BODY_MARS,
+    BODY_JUPITER,
+    BODY_SATURN,
+    BODY_URANUS,
+    BODY_NEPTUNE,
+    BODY_PLUTO,
+    BODY_MOON,
+    NUM_BODIES
+};
+
 struct ZodiacInfo {
     double right_ascension;
     int sign_index;
@@ -67,6 +86,21 @@ struct RectCoords {
         x(0), y(0), z(0) {}
 };
 
+struct RotMatrix {
+    double m[3][3];
+
+    RotMatrix():
+        m() {}
+};
+
+struct StateVector {
+    RectCoords position;
+    RectCoords velocity;    // Per day
+
+    StateVector():
+        position(), velocity() {}
+};
+
 struct OrbElem {
     double sma;     // Semi-major axis
     double ecc;     // Eccentricity
@@ -77,11 +111,11 @@ struct OrbElem {
     double man;     // Mean anomaly
     double arp;     // Argument of perihelion
 
-    OrbElem() :
+    constexpr OrbElem() :
         sma(0), ecc(0), inc(0), ml(0),
         lp(0), lan(0), man(0), arp(0) {}
 
-    OrbElem(const double sma, const double ecc,
+    constexpr OrbElem(const double sma, const double ecc,
             const double inc, const double ml,
             const double lp, const double lan,
             const double man, const double arp) :
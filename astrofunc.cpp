@@ -11,14 +11,16 @@
  */
 
 
-#include <sstream>
-#include <iomanip>
 #include <string>
 #include <cmath>
+#include <cstddef>
 #include <cassert>
+#include <stdint.h>
 #include <paulgrif/utctime.h>
 #include "astro_common_types.h"
 #include "astrofunc.h"
+#include "julian_date.h"
+#include "zodiac.h"
 
 using std::cos;
 using std::sin;
@@ -27,12 +29,54 @@ using std::atan2;
 using std::fabs;
 using std::floor;
 using std::ceil;
-using std::pow;
 using std::sqrt;
 
 using namespace astro;
 
 
+/*
+ *  Local constants and function prototypes
+ */
+
+namespace {
+
+//  Default accuracy to which, and maximum number of iterations
+//  with which, Kepler's equation is solved
+
+const double kepler_accuracy = 1e-6;
+const int kepler_max_iterations = 50;
+
+//  Number of equations solved in lockstep by kepler_batch()
+
+const size_t kepler_lanes = 4;
+
+//  Number of coordinates converted per block by ecl_to_sph()
+
+const size_t sph_block_size = 256;
+
+//  Names of the zodiac signs
+
+const char * const zodiac_signs[] = {
+    "Aries", "Taurus", "Gemini", "Cancer",
+    "Leo", "Virgo", "Libra", "Scorpio",
+    "Sagittarius", "Capricorn", "Aquarius", "Pisces"
+};
+const char * const zodiac_signs_short[] = {
+    "AR", "TA", "GE", "CN", "LE", "VI",
+    "LI", "SC", "SG", "CP", "AQ", "PI"
+};
+
+void kepler_block(const double * m_anom, const double * ecc,
+                  double * e_anom);
+double reduce_m_anom(const double m_anom, double& offset);
+double kepler_start(const double m_anom, const double ecc);
+void small_sincos(const double x, double& sin_x, double& cos_x);
+char * write_two_digits(char * buffer, const int value);
+char * write_padded_int(char * buffer, const int value, const int width);
+
+}           //  namespace
+
+
 /*
  *  Converts a degree angle to hours, minutes and seconds
  *  and stores the result (and modifies) the supplied
@@ -87,7 +131,7 @@ void astro::deg_to_dms(const double degrees, DMS& dmsout) {
  */
 
 double astro::hypot(const double opp, const double adj) {
-    return sqrt(pow(opp, 2) + pow(adj, 2));
+    return sqrt(opp * opp + adj * adj);
 }
 
 
@@ -98,16 +142,6 @@ double astro::hypot(const double opp, const double adj) {
  */
 
 void astro::get_zodiac_info(const double rasc, ZodiacInfo& zInfo) {
-    static const char * const zodiac_signs[] = {
-        "Aries", "Taurus", "Gemini", "Cancer",
-        "Leo", "Virgo", "Libra", "Scorpio",
-        "Sagittarius", "Capricorn", "Aquarius", "Pisces"
-    };
-    static const char * const zodiac_signs_short[] = {
-        "AR", "TA", "GE", "CN", "LE", "VI",
-        "LI", "SC", "SG", "CP", "AQ", "PI"
-    };
-
     const double norm_degs = normalize_degrees(rasc);
     DMS dms;
     deg_to_dms(norm_degs, dms);
@@ -138,12 +172,34 @@ void astro::get_zodiac_info(const double rasc, ZodiacInfo& zInfo) {
  */
 
 double astro::julian_date(const utctime::UTCTime& utc_time) {
-    static const double epoch_j2000 = 2451545;
     static const double secs_in_a_day = 86400;
-    static const utctime::UTCTime utc_j2000(2000, 1, 1, 12, 0, 0);
-        
-    const double days_since_j2000 = (utc_time - utc_j2000) / secs_in_a_day;
-    return epoch_j2000 + days_since_j2000;
+
+    return EPOCH_UNIX + utc_time.timestamp() / secs_in_a_day;
+}
+
+
+/*
+ *  Calculates the number of Julian centuries since J2000 for
+ *  the supplied UTC time.
+ */
+
+double astro::julian_centuries(const utctime::UTCTime& utc_time) {
+    return (julian_date(utc_time) - EPOCH_J2000) / JDAYS_PER_CENT;
+}
+
+
+/*
+ *  Converts geocentric ecliptic coordinates to geocentric
+ *  equatorial coordinates.
+ *
+ *  This function stores the result in (and modifies) the supplied
+ *  RectCoords struct.
+ */
+
+void astro::ecl_to_equ(const RectCoords& ecl, RectCoords& equ) {
+    equ.x = ecl.x;
+    equ.y = ecl.y * COS_OBLIQUITY - ecl.z * SIN_OBLIQUITY;
+    equ.z = ecl.y * SIN_OBLIQUITY + ecl.z * COS_OBLIQUITY;
 }
 
 
@@ -159,20 +215,265 @@ double astro::julian_date(const utctime::UTCTime& utc_time) {
  */
 
 double astro::kepler(const double m_anom, const double ecc) {
-    const double desired_accuracy = 1e-6;
+    int iterations;
+    return kepler(m_anom, ecc, kepler_accuracy,
+                  kepler_max_iterations, iterations);
+}
+
+
+/*
+ *  Solves Kepler's equation to a specified accuracy.
+ *
+ *  The mean anomaly is reduced to the range -pi <= M < pi, and
+ *  Newton's method is started from Danby's initial guess
+ *  E = M + 0.85e (with the sign of M), which converges in a small
+ *  and predictable number of iterations even at high eccentricities.
+ *
+ *  Arguments:
+ *    m_anom - mean anomaly, in radians
+ *    ecc - eccentricity
+ *    accuracy - iteration stops when the error in Kepler's equation
+ *               is no greater than this value
+ *    max_iterations - iteration stops after this number of
+ *                     iterations, even if accuracy has not been reached
+ *    iterations - modified to contain the number of iterations used
+ *
+ *  Returns:
+ *    the eccentric anomaly, in radians, differing from the supplied
+ *    mean anomaly by less than pi.
+ */
 
+double astro::kepler(const double m_anom, const double ecc,
+                     const double accuracy, const int max_iterations,
+                     int& iterations) {
     assert(ecc >= 0);       // Eccentricity is 0 for a circle
     assert(ecc < 1);        // Eccentricity is less than 1 for an ellipse
+    assert(accuracy > 0);
+    assert(max_iterations > 0);
 
-    double e_anom = m_anom;
+    double offset;
+    const double m_red = reduce_m_anom(m_anom, offset);
+    double e_anom = kepler_start(m_red, ecc);
     double diff;
 
+    iterations = 0;
+
     do {
-        diff = e_anom - ecc * sin(e_anom) - m_anom;
+        diff = e_anom - ecc * sin(e_anom) - m_red;
         e_anom -= diff / (1 - ecc * cos(e_anom));
-    } while ( fabs(diff) > desired_accuracy );
+        ++iterations;
+    } while ( fabs(diff) > accuracy && iterations < max_iterations );
+
+    return e_anom + offset;
+}
+
+
+/*
+ *  Solves Kepler's equation for arrays of mean anomalies and
+ *  eccentricities.
+ *
+ *  Arguments:
+ *    m_anom - an array of mean anomalies, in radians
+ *    ecc - an array of eccentricities
+ *    e_anom - an array of at least count elements, in which the
+ *             eccentric anomalies, in radians, are stored
+ *    count - the number of elements in m_anom and ecc
+ *
+ *  The equations are solved in small blocks, iterating in lockstep
+ *  until every equation in the block has converged. The results
+ *  agree with kepler() to within its accuracy.
+ */
 
-    return e_anom;
+void astro::kepler_batch(const double * m_anom, const double * ecc,
+                         double * e_anom, const size_t count) {
+    size_t i = 0;
+
+    for ( ; i + kepler_lanes <= count; i += kepler_lanes ) {
+        kepler_block(m_anom + i, ecc + i, e_anom + i);
+    }
+
+    //  Pad out any remaining equations to a full block
+
+    if ( i < count ) {
+        double m_block[kepler_lanes] = {0};
+        double ecc_block[kepler_lanes] = {0};
+        double e_block[kepler_lanes];
+
+        for ( size_t j = 0; i + j < count; ++j ) {
+            m_block[j] = m_anom[i + j];
+            ecc_block[j] = ecc[i + j];
+        }
+
+        kepler_block(m_block, ecc_block, e_block);
+
+        for ( size_t j = 0; i + j < count; ++j ) {
+            e_anom[i + j] = e_block[j];
+        }
+    }
+}
+
+
+/*
+ *  Calculates heliocentric coordinates in the orbital plane from
+ *  the supplied orbital elements.
+ *
+ *  The z member is set to the heliocentric distance, rather than
+ *  to zero.
+ *
+ *  This function stores the result in (and modifies) the supplied
+ *  RectCoords struct.
+ */
+
+void astro::orbital_coords(const OrbElem& oes, RectCoords& hoc) {
+    const double e_anom = kepler(oes.man, oes.ecc);
+
+    hoc.x = oes.sma * (cos(e_anom) - oes.ecc);
+    hoc.y = oes.sma * sqrt(1 - oes.ecc * oes.ecc) * sin(e_anom);
+    hoc.z = hypot(hoc.x, hoc.y);
+}
+
+
+/*
+ *  Converts heliocentric coordinates in the orbital plane to
+ *  heliocentric coordinates in the J2000 ecliptic plane, using
+ *  the supplied orbital elements.
+ *
+ *  This function stores the result in (and modifies) the supplied
+ *  RectCoords struct.
+ */
+
+void astro::orb_to_ecl(const OrbElem& oes, const RectCoords& hoc,
+                       RectCoords& hec) {
+    RotMatrix rot;
+    orb_to_ecl_matrix(oes, rot);
+    orb_to_ecl(rot, hoc, hec);
+}
+
+
+/*
+ *  Calculates the matrix which rotates heliocentric coordinates in
+ *  the orbital plane to the J2000 ecliptic plane for the supplied
+ *  orbital elements, with six trigonometric function calls.
+ *
+ *  The first two columns rotate the x and y orbital coordinates, and
+ *  the third is the normal to the orbital plane.
+ *
+ *  This function stores the result in (and modifies) the supplied
+ *  RotMatrix struct.
+ */
+
+void astro::orb_to_ecl_matrix(const OrbElem& oes, RotMatrix& rot) {
+    const double cos_arp = cos(oes.arp);
+    const double sin_arp = sin(oes.arp);
+    const double cos_lan = cos(oes.lan);
+    const double sin_lan = sin(oes.lan);
+    const double cos_inc = cos(oes.inc);
+    const double sin_inc = sin(oes.inc);
+
+    rot.m[0][0] = cos_arp * cos_lan - sin_arp * sin_lan * cos_inc;
+    rot.m[0][1] = -sin_arp * cos_lan - cos_arp * sin_lan * cos_inc;
+    rot.m[0][2] = sin_lan * sin_inc;
+    rot.m[1][0] = cos_arp * sin_lan + sin_arp * cos_lan * cos_inc;
+    rot.m[1][1] = -sin_arp * sin_lan + cos_arp * cos_lan * cos_inc;
+    rot.m[1][2] = -cos_lan * sin_inc;
+    rot.m[2][0] = sin_arp * sin_inc;
+    rot.m[2][1] = cos_arp * sin_inc;
+    rot.m[2][2] = cos_inc;
+}
+
+
+/*
+ *  Converts heliocentric coordinates in the orbital plane to
+ *  heliocentric coordinates in the J2000 ecliptic plane, using
+ *  a matrix calculated by orb_to_ecl_matrix().
+ *
+ *  The z member of the orbital coordinates holds the distance, as
+ *  set by orbital_coords(), and is ignored.
+ *
+ *  This function stores the result in (and modifies) the supplied
+ *  RectCoords struct.
+ */
+
+void astro::orb_to_ecl(const RotMatrix& rot, const RectCoords& hoc,
+                       RectCoords& hec) {
+    hec.x = rot.m[0][0] * hoc.x + rot.m[0][1] * hoc.y;
+    hec.y = rot.m[1][0] * hoc.x + rot.m[1][1] * hoc.y;
+    hec.z = rot.m[2][0] * hoc.x + rot.m[2][1] * hoc.y;
+}
+
+
+/*
+ *  Calculates heliocentric position and velocity in the J2000
+ *  ecliptic plane from the supplied orbital elements and their
+ *  rates of change.
+ *
+ *  Arguments:
+ *    oes - the orbital elements, as used by orbital_coords()
+ *    rates - the rates of change of each of the orbital elements,
+ *            including the mean anomaly and argument of perihelion,
+ *            per day
+ *    hec - the position, in AU, is stored in (and modifies) this
+ *    hev - the velocity, in AU per day, is stored in (and
+ *          modifies) this
+ *
+ *  The velocity is calculated analytically, using the rate of change
+ *  of the eccentric anomaly found by differentiating Kepler's
+ *  equation, rather than by differencing positions. The position
+ *  agrees with that from orbital_coords() and orb_to_ecl() to within
+ *  rounding error.
+ */
+
+void astro::orbital_state(const OrbElem& oes, const OrbElem& rates,
+                          RectCoords& hec, RectCoords& hev) {
+    const double e_anom = kepler(oes.man, oes.ecc);
+    const double cos_e = cos(e_anom);
+    const double sin_e = sin(e_anom);
+    const double root_1me2 = sqrt(1 - oes.ecc * oes.ecc);
+
+    //  Differentiating E - e sin E = M gives the rate of change of
+    //  the eccentric anomaly
+
+    const double e_anom_rate = (rates.man + sin_e * rates.ecc) /
+                               (1 - oes.ecc * cos_e);
+
+    //  Position and velocity in the orbital plane
+
+    const double x = oes.sma * (cos_e - oes.ecc);
+    const double y = oes.sma * root_1me2 * sin_e;
+    const double vx = rates.sma * (cos_e - oes.ecc) -
+                      oes.sma * (sin_e * e_anom_rate + rates.ecc);
+    const double vy = (rates.sma * root_1me2 -
+                       oes.sma * oes.ecc * rates.ecc / root_1me2) * sin_e +
+                      oes.sma * root_1me2 * cos_e * e_anom_rate;
+
+    //  Rotate through the argument of perihelion...
+
+    const double cos_w = cos(oes.arp);
+    const double sin_w = sin(oes.arp);
+    const double u = x * cos_w - y * sin_w;
+    const double v = x * sin_w + y * cos_w;
+    const double vu = vx * cos_w - vy * sin_w - rates.arp * v;
+    const double vv = vx * sin_w + vy * cos_w + rates.arp * u;
+
+    //  ...the inclination...
+
+    const double cos_i = cos(oes.inc);
+    const double sin_i = sin(oes.inc);
+    const double qy = v * cos_i;
+    const double qz = v * sin_i;
+    const double vqy = vv * cos_i - rates.inc * qz;
+    const double vqz = vv * sin_i + rates.inc * qy;
+
+    //  ...and the longitude of the ascending node
+
+    const double cos_n = cos(oes.lan);
+    const double sin_n = sin(oes.lan);
+    hec.x = u * cos_n - qy * sin_n;
+    hec.y = u * sin_n + qy * cos_n;
+    hec.z = qz;
+    hev.x = vu * cos_n - vqy * sin_n - rates.lan * hec.y;
+    hev.y = vu * sin_n + vqy * cos_n + rates.lan * hec.x;
+    hev.z = vqz;
 }
 
 
@@ -184,9 +485,75 @@ double astro::kepler(const double m_anom, const double ecc) {
  */
 
 void astro::rec_to_sph(const RectCoords& rcd, SphCoords& scd) {
+    const double rho_sq = rcd.x * rcd.x + rcd.y * rcd.y;
+
     scd.right_ascension = degrees(atan2(rcd.y, rcd.x));
-    scd.declination = degrees(atan(rcd.z / hypot(rcd.x, rcd.y)));
-    scd.distance = sqrt(pow(rcd.x, 2) + pow(rcd.y, 2) + pow(rcd.z, 2));
+    scd.declination = degrees(atan(rcd.z / sqrt(rho_sq)));
+    scd.distance = sqrt(rho_sq + rcd.z * rcd.z);
+}
+
+
+/*
+ *  Converts geocentric ecliptic coordinates to geocentric equatorial
+ *  spherical coordinates in a single pass, equivalent to calling
+ *  ecl_to_equ() and then rec_to_sph().
+ *
+ *  This function stores the result in (and modifies) the supplied
+ *  SphCoords struct.
+ */
+
+void astro::ecl_to_sph(const RectCoords& ecl, SphCoords& scd) {
+    const double y = ecl.y * COS_OBLIQUITY - ecl.z * SIN_OBLIQUITY;
+    const double z = ecl.y * SIN_OBLIQUITY + ecl.z * COS_OBLIQUITY;
+    const double rho_sq = ecl.x * ecl.x + y * y;
+
+    scd.right_ascension = degrees(atan2(y, ecl.x));
+    scd.declination = degrees(atan(z / sqrt(rho_sq)));
+    scd.distance = sqrt(rho_sq + z * z);
+}
+
+
+/*
+ *  Converts an array of geocentric ecliptic coordinates to geocentric
+ *  equatorial spherical coordinates.
+ *
+ *  Arguments:
+ *    ecl - an array of geocentric ecliptic coordinates
+ *    count - the number of elements in ecl
+ *    rasc, decl, dist - arrays of at least count elements, in which
+ *                       the right ascensions and declinations, in
+ *                       degrees, and distances are stored
+ *
+ *  The coordinates are converted in blocks, first rotating them and
+ *  calculating the distances in a loop free of function calls which
+ *  the compiler can vectorize, and then calculating the angles. The
+ *  results are identical to those of the single coordinate version.
+ */
+
+void astro::ecl_to_sph(const RectCoords * ecl, const size_t count,
+                       double * rasc, double * decl, double * dist) {
+    double y[sph_block_size];
+    double z[sph_block_size];
+    double rho[sph_block_size];
+
+    for ( size_t start = 0; start < count; start += sph_block_size ) {
+        const RectCoords * block = ecl + start;
+        const size_t n = count - start < sph_block_size ?
+                         count - start : sph_block_size;
+
+        for ( size_t i = 0; i < n; ++i ) {
+            y[i] = block[i].y * COS_OBLIQUITY - block[i].z * SIN_OBLIQUITY;
+            z[i] = block[i].y * SIN_OBLIQUITY + block[i].z * COS_OBLIQUITY;
+            const double rho_sq = block[i].x * block[i].x + y[i] * y[i];
+            rho[i] = sqrt(rho_sq);
+            dist[start + i] = sqrt(rho_sq + z[i] * z[i]);
+        }
+
+        for ( size_t i = 0; i < n; ++i ) {
+            rasc[start + i] = degrees(atan2(y[i], block[i].x));
+            decl[start + i] = degrees(atan(z[i] / rho[i]));
+        }
+    }
 }
 
 
@@ -197,9 +564,9 @@ void astro::rec_to_sph(const RectCoords& rcd, SphCoords& scd) {
  */
 
 const char * astro::zodiac_sign(const double rasc) {
-    ZodiacInfo zInfo;
-    get_zodiac_info(rasc, zInfo);
-    return zInfo.sign_name;
+    uint8_t sign_index;
+    classify_zodiac(&rasc, &sign_index, 0, 1);
+    return zodiac_signs[sign_index];
 }
 
 
@@ -210,9 +577,9 @@ const char * astro::zodiac_sign(const double rasc) {
  */
 
 const char * astro::zodiac_sign_short(const double rasc) {
-    ZodiacInfo zInfo;
-    get_zodiac_info(rasc, zInfo);
-    return zInfo.sign_short_name;
+    uint8_t sign_index;
+    classify_zodiac(&rasc, &sign_index, 0, 1);
+    return zodiac_signs_short[sign_index];
 }
 
 
@@ -222,15 +589,9 @@ const char * astro::zodiac_sign_short(const double rasc) {
  */
 
 std::string astro::rasc_to_zodiac(const double rasc) {
-    ZodiacInfo zInfo;
-    get_zodiac_info(rasc, zInfo);
-
-    std::ostringstream oStream;
-    oStream << std::setfill('0');
-    oStream << std::setw(2) << zInfo.degrees << zInfo.sign_short_name
-            << std::setw(2) << zInfo.minutes;
-    
-    return oStream.str();
+    char buffer[ZODIAC_STRING_SIZE];
+    const size_t length = rasc_to_zodiac(rasc, buffer);
+    return std::string(buffer, length);
 }
 
 
@@ -241,16 +602,9 @@ std::string astro::rasc_to_zodiac(const double rasc) {
  */
 
 std::string astro::rasc_string(const double rasc) {
-    HMS hms;
-    deg_to_hms(rasc, hms);
-
-    std::ostringstream oStream;
-    oStream << std::setfill('0');
-    oStream << std::setw(2) << hms.hours << "h "
-            << std::setw(2) << hms.minutes << "m "
-            << std::setw(2) << hms.seconds << "s";
-    
-    return oStream.str();
+    char buffer[RASC_STRING_SIZE];
+    const size_t length = rasc_string(rasc, buffer);
+    return std::string(buffer, length);
 }
 
 
@@ -261,15 +615,274 @@ std::string astro::rasc_string(const double rasc) {
  */
 
 std::string astro::decl_string(const double decl) {
+    char buffer[DECL_STRING_SIZE];
+    const size_t length = decl_string(decl, buffer);
+    return std::string(buffer, length);
+}
+
+
+/*
+ *  Writes a zodiacal coordinate of the form 20GE19 for the
+ *  supplied right ascension to the supplied buffer, which must
+ *  be at least ZODIAC_STRING_SIZE characters long.
+ *
+ *  The output is null terminated, and its length, excluding the
+ *  terminating null character, is returned. No memory is allocated.
+ */
+
+size_t astro::rasc_to_zodiac(const double rasc, char * buffer) {
+    ZodiacInfo zInfo;
+    get_zodiac_info(rasc, zInfo);
+
+    char * p = write_two_digits(buffer, zInfo.degrees);
+    *p++ = zInfo.sign_short_name[0];
+    *p++ = zInfo.sign_short_name[1];
+    p = write_two_digits(p, zInfo.minutes);
+    *p = '\0';
+
+    return p - buffer;
+}
+
+
+/*
+ *  Writes a string representation in the form "12h 10m 30s" of
+ *  the hours-minutes-seconds representation of the supplied right
+ *  ascension to the supplied buffer, which must be at least
+ *  RASC_STRING_SIZE characters long.
+ *
+ *  The output is null terminated, and its length, excluding the
+ *  terminating null character, is returned. No memory is allocated.
+ */
+
+size_t astro::rasc_string(const double rasc, char * buffer) {
+    HMS hms;
+    deg_to_hms(rasc, hms);
+
+    char * p = write_two_digits(buffer, hms.hours);
+    *p++ = 'h';
+    *p++ = ' ';
+    p = write_two_digits(p, hms.minutes);
+    *p++ = 'm';
+    *p++ = ' ';
+    p = write_two_digits(p, hms.seconds);
+    *p++ = 's';
+    *p = '\0';
+
+    return p - buffer;
+}
+
+
+/*
+ *  Writes a string representation in the form "+12d 10m 30s" of
+ *  the degrees-minutes-seconds representation of the supplied
+ *  declination to the supplied buffer, which must be at least
+ *  DECL_STRING_SIZE characters long.
+ *
+ *  The output is null terminated, and its length, excluding the
+ *  terminating null character, is returned. No memory is allocated.
+ */
+
+size_t astro::decl_string(const double decl, char * buffer) {
     DMS dms;
     deg_to_dms(decl, dms);
 
-    std::ostringstream oStream;
-    oStream << std::setfill('0');
-    oStream << (dms.degrees >= 0 ? "+" : "")
-            << std::setw(2) << dms.degrees << "d "
-            << std::setw(2) << fabs(dms.minutes) << "m "
-            << std::setw(2) << fabs(dms.seconds) << "s";
-    
-    return oStream.str();
+    char * p = buffer;
+    if ( dms.degrees >= 0 ) {
+        *p++ = '+';
+    }
+    p = write_padded_int(p, dms.degrees, 2);
+    *p++ = 'd';
+    *p++ = ' ';
+    p = write_two_digits(p, dms.minutes < 0 ? -dms.minutes : dms.minutes);
+    *p++ = 'm';
+    *p++ = ' ';
+    p = write_two_digits(p, dms.seconds < 0 ? -dms.seconds : dms.seconds);
+    *p++ = 's';
+    *p = '\0';
+
+    return p - buffer;
+}
+
+
+namespace {
+
+/*
+ *  Solves Kepler's equation for one block of kepler_lanes equations,
+ *  using Newton's method in the same way as kepler().
+ *
+ *  sin() and cos() of the eccentric anomaly are calculated once at
+ *  the start, and thereafter updated by rotating through each
+ *  (usually small) Newton correction, so that the iterations consist
+ *  only of arithmetic on short arrays which the compiler is free to
+ *  vectorize. Corrections too large for the rotation to be accurate
+ *  fall back to calling sin() and cos() directly.
+ */
+
+void kepler_block(const double * m_anom, const double * ecc,
+                  double * e_anom) {
+    static const double max_rotation = 0.5;
+
+    double m_red[kepler_lanes];
+    double offset[kepler_lanes];
+    double sin_e[kepler_lanes];
+    double cos_e[kepler_lanes];
+    double corr[kepler_lanes];
+    bool converged[kepler_lanes];
+
+    for ( size_t j = 0; j < kepler_lanes; ++j ) {
+        assert(ecc[j] >= 0);
+        assert(ecc[j] < 1);
+
+        m_red[j] = reduce_m_anom(m_anom[j], offset[j]);
+        e_anom[j] = kepler_start(m_red[j], ecc[j]);
+        sin_e[j] = sin(e_anom[j]);
+        cos_e[j] = cos(e_anom[j]);
+        converged[j] = false;
+    }
+
+    bool all_converged = false;
+
+    for ( int n = 0; !all_converged && n < kepler_max_iterations; ++n ) {
+        all_converged = true;
+
+        //  Newton step. As with kepler(), the correction is still
+        //  applied on the iteration at which an equation converges.
+
+        for ( size_t j = 0; j < kepler_lanes; ++j ) {
+            const double diff = e_anom[j] - ecc[j] * sin_e[j] - m_red[j];
+            corr[j] = converged[j] ? 0 : diff / (1 - ecc[j] * cos_e[j]);
+            e_anom[j] -= corr[j];
+            converged[j] = converged[j] || fabs(diff) <= kepler_accuracy;
+            all_converged = all_converged && converged[j];
+        }
+
+        //  Rotate sin() and cos() through the correction
+
+        for ( size_t j = 0; j < kepler_lanes; ++j ) {
+            double sin_c, cos_c;
+            small_sincos(corr[j], sin_c, cos_c);
+
+            const double new_sin = sin_e[j] * cos_c - cos_e[j] * sin_c;
+            cos_e[j] = cos_e[j] * cos_c + sin_e[j] * sin_c;
+            sin_e[j] = new_sin;
+        }
+
+        for ( size_t j = 0; j < kepler_lanes; ++j ) {
+            if ( fabs(corr[j]) > max_rotation ) {
+                sin_e[j] = sin(e_anom[j]);
+                cos_e[j] = cos(e_anom[j]);
+            }
+        }
+    }
+
+    for ( size_t j = 0; j < kepler_lanes; ++j ) {
+        e_anom[j] += offset[j];
+    }
+}
+
+
+/*
+ *  Reduces a mean anomaly, in radians, to the range -pi <= M < pi,
+ *  and stores in (and modifies) offset the multiple of 2 pi which
+ *  was subtracted.
+ */
+
+double reduce_m_anom(const double m_anom, double& offset) {
+    offset = 2 * PI * floor((m_anom + PI) / (2 * PI));
+    return m_anom - offset;
+}
+
+
+/*
+ *  Returns Danby's starting value for the eccentric anomaly, for
+ *  a mean anomaly already reduced to the range -pi <= M < pi.
+ */
+
+double kepler_start(const double m_anom, const double ecc) {
+    return m_anom + (m_anom >= 0 ? 0.85 : -0.85) * ecc;
+}
+
+
+/*
+ *  Calculates sin() and cos() of a small angle, in radians, from
+ *  their Taylor series. Accurate to better than 1e-16 for angles
+ *  up to 0.5 radians in magnitude.
+ */
+
+void small_sincos(const double x, double& sin_x, double& cos_x) {
+    static const double s3 = -1.0 / 6;
+    static const double s5 = 1.0 / 120;
+    static const double s7 = -1.0 / 5040;
+    static const double s9 = 1.0 / 362880;
+    static const double s11 = -1.0 / 39916800;
+    static const double s13 = 1.0 / 6227020800.0;
+    static const double c2 = -1.0 / 2;
+    static const double c4 = 1.0 / 24;
+    static const double c6 = -1.0 / 720;
+    static const double c8 = 1.0 / 40320;
+    static const double c10 = -1.0 / 3628800;
+    static const double c12 = 1.0 / 479001600;
+    static const double c14 = -1.0 / 87178291200.0;
+
+    const double x2 = x * x;
+
+    sin_x = x * (1 + x2 * (s3 + x2 * (s5 + x2 * (s7 + x2 * (s9 +
+            x2 * (s11 + x2 * s13))))));
+    cos_x = 1 + x2 * (c2 + x2 * (c4 + x2 * (c6 + x2 * (c8 + x2 * (c10 +
+            x2 * (c12 + x2 * c14))))));
+}
+
+
+
+/*
+ *  Writes the supplied integer, which must be in the range 0 to 99,
+ *  as two decimal digits to the supplied buffer. Returns a pointer
+ *  to the character following the last one written. The output is
+ *  not null terminated.
+ */
+
+char * write_two_digits(char * buffer, const int value) {
+    assert(value >= 0 && value < 100);
+
+    *buffer++ = '0' + value / 10;
+    *buffer++ = '0' + value % 10;
+    return buffer;
 }
+
+
+/*
+ *  Writes the decimal representation of the supplied integer to
+ *  the supplied buffer, padded on the left with zeroes to at
+ *  least the specified width, in the same way as an ostream with
+ *  setfill('0') and setw(width) would. Returns a pointer to the
+ *  character following the last one written. The output is not
+ *  null terminated.
+ */
+
+char * write_padded_int(char * buffer, const int value, const int width) {
+    char digits[12];
+    int num_digits = 0;
+
+    //  Work with a negative value so that INT_MIN is handled
+
+    int v = value < 0 ? value : -value;
+    do {
+        digits[num_digits++] = '0' - v % 10;
+        v /= 10;
+    } while ( v != 0 );
+
+    const int length = num_digits + (value < 0 ? 1 : 0);
+    for ( int i = length; i < width; ++i ) {
+        *buffer++ = '0';
+    }
+    if ( value < 0 ) {
+        *buffer++ = '-';
+    }
+    while ( num_digits > 0 ) {
+        *buffer++ = digits[--num_digits];
+    }
+
+    return buffer;
+}
+
+}           //  namespace
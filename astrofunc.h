@@ -16,6 +16,7 @@
 
 #include <string>
 #include <cmath>
+#include <cstddef>
 #include <paulgrif/utctime.h>
 #include "astro_common_types.h"
 
@@ -26,7 +27,17 @@ namespace astro {
  *  Constants
  */
 
-const double PI = 3.14159265358979323846;
+constexpr double PI = 3.14159265358979323846;
+constexpr double EPOCH_J2000 = 2451545;
+constexpr double JDAYS_PER_CENT = 36525;
+
+//  Minimum sizes of the buffers passed to the char buffer versions
+//  of rasc_to_zodiac(), rasc_string() and decl_string(), including
+//  the terminating null character
+
+constexpr size_t ZODIAC_STRING_SIZE = 8;
+constexpr size_t RASC_STRING_SIZE = 12;
+constexpr size_t DECL_STRING_SIZE = 24;
 
 
 /*
@@ -38,13 +49,33 @@ void deg_to_dms(const double degrees, DMS& dmsout);
 double hypot(const double opp, const double adj);
 void get_zodiac_info(const double rasc, ZodiacInfo& zInfo);
 double julian_date(const utctime::UTCTime& utc_time);
+double julian_centuries(const utctime::UTCTime& utc_time);
+void ecl_to_equ(const RectCoords& ecl, RectCoords& equ);
 double kepler(const double m_anom, const double ecc);
+double kepler(const double m_anom, const double ecc,
+              const double accuracy, const int max_iterations,
+              int& iterations);
+void kepler_batch(const double * m_anom, const double * ecc,
+                  double * e_anom, const size_t count);
+void orbital_coords(const OrbElem& oes, RectCoords& hoc);
+void orb_to_ecl(const OrbElem& oes, const RectCoords& hoc, RectCoords& hec);
+void orb_to_ecl_matrix(const OrbElem& oes, RotMatrix& rot);
+void orb_to_ecl(const RotMatrix& rot, const RectCoords& hoc,
+                RectCoords& hec);
+void orbital_state(const OrbElem& oes, const OrbElem& rates,
+                   RectCoords& hec, RectCoords& hev);
 void rec_to_sph(const RectCoords& rcd, SphCoords& scd);
+void ecl_to_sph(const RectCoords& ecl, SphCoords& scd);
+void ecl_to_sph(const RectCoords * ecl, const size_t count,
+                double * rasc, double * decl, double * dist);
 const char * zodiac_sign(const double rasc);
 const char * zodiac_sign_short(const double rasc);
 std::string rasc_to_zodiac(const double rasc);
 std::string rasc_string(const double rasc);
 std::string decl_string(const double decl);
+size_t rasc_to_zodiac(const double rasc, char * buffer);
+size_t rasc_string(const double rasc, char * buffer);
+size_t decl_string(const double decl, char * buffer);
 
 
 /*
@@ -66,7 +97,7 @@ inline double normalize_degrees(const double angle) {
  *  Converts radians to degrees.
  */
 
-inline double degrees(const double rads) {
+constexpr double degrees(const double rads) {
     return rads / (PI / 180);
 }
 
@@ -75,10 +106,20 @@ inline double degrees(const double rads) {
  *  Converts degrees to radians.
  */
 
-inline double radians(const double degs) {
+constexpr double radians(const double degs) {
     return degs * (PI / 180);
 }
 
+
+/*
+ *  Obliquity of the ecliptic at J2000, in radians, and its cosine
+ *  and sine.
+ */
+
+constexpr double OBLIQUITY = radians(23.43928);
+constexpr double COS_OBLIQUITY = 0.9174821392082875;
+constexpr double SIN_OBLIQUITY = 0.3977769780087639;
+
 }           //  namespace astro
 
 #endif          // PG_ASTRO_ASTROFUNC_H
@@ -0,0 +1,518 @@
+/*
+ *  benchmarks.cpp
+ *  ==============
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Micro and macro benchmarks for the astronomical library.
+ *
+ *  Each benchmark is first run for a doubling number of iterations
+ *  until one run takes at least min_run_time, which also serves as
+ *  a warmup. It is then run for that number of iterations a further
+ *  num_repetitions times, and the fastest and median times per
+ *  operation are reported.
+ *
+ *  Results are written to standard output in CSV format, or in JSON
+ *  format if the --json option is given.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstddef>
+#include <stdint.h>
+#include <paulgrif/utctime.h>
+#include "../astro.h"
+
+using namespace astro;
+
+
+namespace {
+
+const double min_run_time = 0.02;       //  Seconds
+const int num_repetitions = 5;
+const size_t num_inputs = 64;
+
+struct BenchResult {
+    BenchResult(const std::string& n, const long iters,
+                const double min, const double median) :
+        name(n), iterations(iters), min_ns(min), median_ns(median) {}
+
+    std::string name;
+    long iterations;
+    double min_ns;
+    double median_ns;
+};
+
+//  Inputs, varied between iterations so that the compiler cannot
+//  hoist the calculations out of the benchmark loops.
+
+std::vector<utctime::UTCTime> times;
+int64_t unix_secs[num_inputs];
+double m_anoms[num_inputs];
+double eccs[num_inputs];
+double angles[num_inputs];
+RectCoords coords[num_inputs];
+RotMatrix rotations[num_inputs];
+
+//  Results are accumulated here so they are not optimized away.
+
+volatile double sink;
+
+
+/*
+ *  Runs the supplied operation for the specified number of
+ *  iterations, and returns the elapsed time in seconds.
+ */
+
+template <class Op>
+double time_op(Op op, const long iterations) {
+    typedef std::chrono::steady_clock Clock;
+
+    double acc = 0;
+    const Clock::time_point start = Clock::now();
+
+    for ( long i = 0; i < iterations; ++i ) {
+        acc += op(i % num_inputs);
+    }
+
+    const Clock::time_point end = Clock::now();
+    sink = acc;
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+
+/*
+ *  Runs a single benchmark.
+ */
+
+template <class Op>
+BenchResult run_bench(const std::string& name, Op op) {
+    long iterations = 1;
+    while ( time_op(op, iterations) < min_run_time ) {
+        iterations *= 2;
+    }
+
+    std::vector<double> ns_per_op;
+    for ( int r = 0; r < num_repetitions; ++r ) {
+        ns_per_op.push_back(time_op(op, iterations) * 1e9 / iterations);
+    }
+    std::sort(ns_per_op.begin(), ns_per_op.end());
+
+    return BenchResult(name, iterations, ns_per_op.front(),
+                       ns_per_op[num_repetitions / 2]);
+}
+
+
+/*
+ *  Helper to benchmark constructing a planet and calculating its
+ *  right ascension.
+ */
+
+template <class P>
+double planet_rasc(const size_t i) {
+    return P(times[i]).right_ascension();
+}
+
+
+/*
+ *  Sets up the benchmark inputs.
+ */
+
+void init_inputs() {
+    for ( size_t i = 0; i < num_inputs; ++i ) {
+        times.push_back(utctime::UTCTime(1950 + i, 1 + i % 12,
+                                         1 + i % 28, i % 24, i % 60, 0));
+        unix_secs[i] = times[i].timestamp();
+        m_anoms[i] = radians(i * 360.0 / num_inputs);
+        eccs[i] = 0.25 * i / num_inputs;
+        angles[i] = i * 359.0 / num_inputs - 30;
+        coords[i].x = 1.0 + i;
+        coords[i].y = 2.0 - i;
+        coords[i].z = 0.5 * i - 3;
+
+        OrbElem oes;
+        oes.arp = radians(angles[i]);
+        oes.lan = m_anoms[i];
+        oes.inc = eccs[i];
+        orb_to_ecl_matrix(oes, rotations[i]);
+    }
+}
+
+
+/*
+ *  Outputs the results.
+ */
+
+void write_csv(std::ostream& out, const std::vector<BenchResult>& results) {
+    out << "benchmark,iterations,repetitions,ns_per_op_min,"
+        << "ns_per_op_median,ops_per_sec" << std::endl;
+
+    for ( size_t i = 0; i < results.size(); ++i ) {
+        const BenchResult& r = results[i];
+        out << r.name << "," << r.iterations << "," << num_repetitions
+            << "," << r.min_ns << "," << r.median_ns << ","
+            << 1e9 / r.median_ns << std::endl;
+    }
+}
+
+void write_json(std::ostream& out, const std::vector<BenchResult>& results) {
+    out << "[" << std::endl;
+
+    for ( size_t i = 0; i < results.size(); ++i ) {
+        const BenchResult& r = results[i];
+        out << "  {\"benchmark\": \"" << r.name << "\", "
+            << "\"iterations\": " << r.iterations << ", "
+            << "\"repetitions\": " << num_repetitions << ", "
+            << "\"ns_per_op_min\": " << r.min_ns << ", "
+            << "\"ns_per_op_median\": " << r.median_ns << ", "
+            << "\"ops_per_sec\": " << 1e9 / r.median_ns << "}"
+            << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+
+    out << "]" << std::endl;
+}
+
+}           //  namespace
+
+
+int main(int argc, char ** argv) {
+    const bool json = (argc > 1 && std::strcmp(argv[1], "--json") == 0);
+
+    init_inputs();
+
+    std::vector<BenchResult> results;
+
+    //  Basic functions
+
+    results.push_back(run_bench("kepler", [](const size_t i) {
+        return kepler(m_anoms[i], eccs[i]);
+    }));
+    results.push_back(run_bench("kepler_batch_64", [](const size_t i) {
+        double e_anoms[num_inputs];
+        kepler_batch(m_anoms, eccs, e_anoms, num_inputs);
+        return e_anoms[i];
+    }));
+    results.push_back(run_bench("julian_date", [](const size_t i) {
+        return julian_date(times[i]);
+    }));
+    results.push_back(run_bench("julian_date_from_unix", [](const size_t i) {
+        return julian_date_from_unix(unix_secs[i]).value();
+    }));
+    results.push_back(run_bench("julian_dates_from_unix_64",
+                                [](const size_t i) {
+        double jdates[num_inputs];
+        julian_dates_from_unix(unix_secs, num_inputs, jdates);
+        return jdates[i];
+    }));
+    results.push_back(run_bench("gmst", [](const size_t i) {
+        return gmst(julian_date_from_unix(unix_secs[i]));
+    }));
+    results.push_back(run_bench("gmst_from_unix_64", [](const size_t i) {
+        double gmsts[num_inputs];
+        gmst_from_unix(unix_secs, num_inputs, gmsts);
+        return gmsts[i];
+    }));
+    results.push_back(run_bench("gmst_uniform_1024", [](const size_t i) {
+        double gmsts[1024];
+        gmst_uniform(julian_date_from_unix(unix_secs[i]), 1.0 / 1440,
+                     1024, gmsts);
+        return gmsts[i];
+    }));
+    results.push_back(run_bench("hour_angles_1024", [](const size_t i) {
+        double gmsts[1024], rasc[1024], has[1024];
+        for ( size_t j = 0; j < 1024; ++j ) {
+            gmsts[j] = angles[(i + j) % num_inputs] + 30;
+            rasc[j] = angles[j % num_inputs] + 30;
+        }
+        hour_angles(gmsts, rasc, 1024, -77.065, has);
+        return has[i];
+    }));
+    results.push_back(run_bench("rec_to_sph", [](const size_t i) {
+        SphCoords sph;
+        rec_to_sph(coords[i], sph);
+        return sph.right_ascension;
+    }));
+    results.push_back(run_bench("ecl_to_equ_rec_to_sph", [](const size_t i) {
+        RectCoords equ;
+        ecl_to_equ(coords[i], equ);
+        SphCoords sph;
+        rec_to_sph(equ, sph);
+        return sph.declination;
+    }));
+    results.push_back(run_bench("ecl_to_sph", [](const size_t i) {
+        SphCoords sph;
+        ecl_to_sph(coords[i], sph);
+        return sph.declination;
+    }));
+    results.push_back(run_bench("ecl_to_sph_64", [](const size_t i) {
+        double rasc[num_inputs], decl[num_inputs], dist[num_inputs];
+        ecl_to_sph(coords, num_inputs, rasc, decl, dist);
+        return decl[i];
+    }));
+
+    //  Planetary positions
+
+    results.push_back(run_bench("Sun::right_ascension", planet_rasc<Sun>));
+    results.push_back(run_bench("Mercury::right_ascension",
+                                planet_rasc<Mercury>));
+    results.push_back(run_bench("Venus::right_ascension",
+                                planet_rasc<Venus>));
+    results.push_back(run_bench("Mars::right_ascension",
+                                planet_rasc<Mars>));
+    results.push_back(run_bench("Jupiter::right_ascension",
+                                planet_rasc<Jupiter>));
+    results.push_back(run_bench("Saturn::right_ascension",
+                                planet_rasc<Saturn>));
+    results.push_back(run_bench("Uranus::right_ascension",
+                                planet_rasc<Uranus>));
+    results.push_back(run_bench("Neptune::right_ascension",
+                                planet_rasc<Neptune>));
+    results.push_back(run_bench("Pluto::right_ascension",
+                                planet_rasc<Pluto>));
+    results.push_back(run_bench("Moon::right_ascension",
+                                planet_rasc<Moon>));
+    results.push_back(run_bench("Mars::right_ascension_from_unix",
+                                [](const size_t i) {
+        return Mars(julian_date_from_unix(unix_secs[i])).right_ascension();
+    }));
+    results.push_back(run_bench("evaluate<BODY_MARS>", [](const size_t i) {
+        SphCoords sph;
+        evaluate<BODY_MARS>(julian_date_from_unix(unix_secs[i]), sph);
+        return sph.right_ascension;
+    }));
+    results.push_back(run_bench("compute(BODY_MARS)", [](const size_t i) {
+        BodyState state;
+        compute(BODY_MARS, julian_date_from_unix(unix_secs[i]), state);
+        return state.right_ascension;
+    }));
+    results.push_back(run_bench("Moon::right_ascension_from_unix",
+                                [](const size_t i) {
+        return Moon(julian_date_from_unix(unix_secs[i])).right_ascension();
+    }));
+    results.push_back(run_bench("compute(BODY_MOON)", [](const size_t i) {
+        BodyState state;
+        compute(BODY_MOON, julian_date_from_unix(unix_secs[i]), state);
+        return state.right_ascension;
+    }));
+    results.push_back(run_bench("Moon::geo_ecl_coords_from_unix",
+                                [](const size_t i) {
+        return Moon(julian_date_from_unix(unix_secs[i])).geo_ecl_coords().x;
+    }));
+    results.push_back(run_bench("geo_ecl_coords(BODY_MOON)",
+                                [](const size_t i) {
+        RectCoords gec;
+        geo_ecl_coords(BODY_MOON, julian_date_from_unix(unix_secs[i]), gec);
+        return gec.x;
+    }));
+    results.push_back(run_bench("topocentric(BODY_MOON)",
+                                [](const size_t i) {
+        TopoCoords topo;
+        topocentric(Observer(angles[i] / 4 - 45, angles[i]), BODY_MOON,
+                    julian_date_from_unix(unix_secs[i]), topo);
+        return topo.altitude;
+    }));
+    results.push_back(run_bench("topocentric_1024_observers",
+                                [](const size_t i) {
+        static std::vector<Observer> observers;
+        if ( observers.empty() ) {
+            for ( size_t j = 0; j < 1024; ++j ) {
+                observers.push_back(Observer(j % 180 - 89.5, j * 0.35));
+            }
+        }
+        TopoCoords topo[1024];
+        topocentric(observers.data(), observers.size(), BODY_MOON,
+                    julian_date_from_unix(unix_secs[i]), topo);
+        return topo[i].altitude;
+    }));
+    results.push_back(run_bench("rise_transit_set(BODY_MOON)",
+                                [](const size_t i) {
+        RiseTransitSet rts;
+        rise_transit_set(BODY_MOON, Observer(angles[i] / 4 - 45, angles[i]),
+                         JulianDate(2451544.5 + i), rts);
+        return rts.rise;
+    }));
+    results.push_back(run_bench("rise_transit_set(BODY_MARS)",
+                                [](const size_t i) {
+        RiseTransitSet rts;
+        rise_transit_set(BODY_MARS, Observer(angles[i] / 4 - 45, angles[i]),
+                         JulianDate(2451544.5 + i), rts);
+        return rts.rise;
+    }));
+    results.push_back(run_bench("Moon::geo_ecl_coords", [](const size_t i) {
+        return Moon(times[i]).geo_ecl_coords().x;
+    }));
+    results.push_back(run_bench("Mars::state", [](const size_t i) {
+        return Mars(times[i]).state().velocity.x;
+    }));
+    results.push_back(run_bench("Moon::state", [](const size_t i) {
+        return Moon(times[i]).state().velocity.x;
+    }));
+    results.push_back(run_bench("moon_geo_ecl_coords_64", [](const size_t i) {
+        double jdates[num_inputs];
+        RectCoords gec[num_inputs];
+        for ( size_t j = 0; j < num_inputs; ++j ) {
+            jdates[j] = 2451545.0 + i + j * 0.1;
+        }
+        moon_geo_ecl_coords(jdates, num_inputs, gec, 0);
+        return gec[i].x;
+    }));
+    results.push_back(run_bench("moon_geo_ecl_coords_7", [](const size_t i) {
+        double jdates[7];
+        RectCoords gec[7];
+        for ( size_t j = 0; j < 7; ++j ) {
+            jdates[j] = 2451545.0 + i + j * 0.1;
+        }
+        moon_geo_ecl_coords(jdates, 7, gec, 0);
+        return gec[i % 7].x;
+    }));
+    results.push_back(run_bench("time_series_moon_1024", [](const size_t i) {
+        double jdates[1024];
+        double rasc[1024], decl[1024], dist[1024];
+        for ( size_t j = 0; j < 1024; ++j ) {
+            jdates[j] = 2451545.0 + i + j * 0.01;
+        }
+        BodyTimeSeries(BODY_MOON).calculate(jdates, 1024,
+                                            rasc, decl, dist);
+        return rasc[i];
+    }));
+    results.push_back(run_bench("solar_system_snapshot", [](const size_t i) {
+        SolarSystemSnapshot snap;
+        solar_system_snapshot(times[i], snap);
+        return snap.bodies[BODY_MOON].right_ascension;
+    }));
+
+    //  Orbital plane to ecliptic rotation
+
+    results.push_back(run_bench("orb_to_ecl", [](const size_t i) {
+        OrbElem oes;
+        oes.arp = radians(angles[i]);
+        oes.lan = m_anoms[i];
+        oes.inc = eccs[i];
+        RectCoords hec;
+        orb_to_ecl(oes, coords[i], hec);
+        return hec.z;
+    }));
+    results.push_back(run_bench("orb_to_ecl_reused_matrix",
+                                [](const size_t i) {
+        RectCoords hec;
+        orb_to_ecl(rotations[i], coords[i], hec);
+        return hec.z;
+    }));
+    results.push_back(run_bench("time_series_mars_1024", [](const size_t i) {
+        double jdates[1024];
+        double rasc[1024], decl[1024], dist[1024];
+        for ( size_t j = 0; j < 1024; ++j ) {
+            jdates[j] = 2451545.0 + i + j * 0.01;
+        }
+        BodyTimeSeries(BODY_MARS).calculate(jdates, 1024,
+                                            rasc, decl, dist);
+        return rasc[i];
+    }));
+    results.push_back(run_bench("time_series_mars_1024_tolerance",
+                                [](const size_t i) {
+        double jdates[1024];
+        double rasc[1024], decl[1024], dist[1024];
+        for ( size_t j = 0; j < 1024; ++j ) {
+            jdates[j] = 2451545.0 + i + j * 0.01;
+        }
+        BodyTimeSeries(BODY_MARS, 1e-8).calculate(jdates, 1024,
+                                                  rasc, decl, dist);
+        return rasc[i];
+    }));
+
+    //  Zodiac classification
+
+    results.push_back(run_bench("zodiac_sign", [](const size_t i) {
+        return static_cast<double>(zodiac_sign(angles[i])[0]);
+    }));
+    results.push_back(run_bench("classify_zodiac_64", [](const size_t i) {
+        uint8_t signs[num_inputs];
+        uint16_t arcmins[num_inputs];
+        classify_zodiac(angles, signs, arcmins, num_inputs);
+        return static_cast<double>(signs[i] + arcmins[i]);
+    }));
+
+    results.push_back(run_bench("find_zodiac_ingresses_mars_year",
+                                [](const size_t i) {
+        std::vector<ZodiacIngress> ingresses;
+        find_zodiac_ingresses(BODY_MARS, 2451545.0 + i, 2451910.0 + i,
+                              ingresses);
+        return static_cast<double>(ingresses.size());
+    }));
+
+    results.push_back(run_bench("find_stations_mercury_year",
+                                [](const size_t i) {
+        std::vector<Station> stations;
+        find_stations(BODY_MERCURY, 2451545.0 + i, 2451910.0 + i, stations);
+        return static_cast<double>(stations.size());
+    }));
+
+    results.push_back(run_bench("find_aspects_9_bodies_year",
+                                [](const size_t i) {
+        const BodyId bodies[] = {BODY_SUN, BODY_MERCURY, BODY_VENUS,
+                                 BODY_MARS, BODY_JUPITER, BODY_SATURN,
+                                 BODY_URANUS, BODY_NEPTUNE, BODY_PLUTO};
+        std::vector<AspectEvent> events;
+        find_aspects(bodies, 9, 2451545.0 + i, 2451910.0 + i, events, 1);
+        return static_cast<double>(events.size());
+    }));
+
+    //  Formatting
+
+    results.push_back(run_bench("rasc_to_zodiac", [](const size_t i) {
+        return static_cast<double>(rasc_to_zodiac(angles[i]).size());
+    }));
+    results.push_back(run_bench("rasc_string", [](const size_t i) {
+        return static_cast<double>(rasc_string(angles[i]).size());
+    }));
+    results.push_back(run_bench("decl_string", [](const size_t i) {
+        return static_cast<double>(decl_string(angles[i] / 4).size());
+    }));
+
+    results.push_back(run_bench("rasc_to_zodiac_buffer", [](const size_t i) {
+        char buffer[ZODIAC_STRING_SIZE];
+        return static_cast<double>(rasc_to_zodiac(angles[i], buffer));
+    }));
+    results.push_back(run_bench("rasc_string_buffer", [](const size_t i) {
+        char buffer[RASC_STRING_SIZE];
+        return static_cast<double>(rasc_string(angles[i], buffer));
+    }));
+    results.push_back(run_bench("decl_string_buffer", [](const size_t i) {
+        char buffer[DECL_STRING_SIZE];
+        return static_cast<double>(decl_string(angles[i] / 4, buffer));
+    }));
+    results.push_back(run_bench("format_position_row", [](const size_t i) {
+        BodyPosition pos;
+        pos.right_ascension = angles[i];
+        pos.declination = angles[i] / 4;
+        pos.distance = coords[i].x;
+        char buffer[POSITION_ROW_SIZE];
+        return static_cast<double>(format_position_row(BODY_MARS, pos,
+                                                       buffer));
+    }));
+
+    //  Whole report
+
+    results.push_back(run_bench("show_planet_positions", [](const size_t) {
+        std::ostringstream out;
+        show_planet_positions(out);
+        return static_cast<double>(out.str().size());
+    }));
+
+    if ( json ) {
+        write_json(std::cout, results);
+    } else {
+        write_csv(std::cout, results);
+    }
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ *  body_state.cpp
+ *  ==============
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of non-virtual position calculations for a single
+ *  body.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <cassert>
+#include <type_traits>
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "julian_date.h"
+#include "element_tables.h"
+#include "moon.h"
+#include "body_state.h"
+
+using namespace astro;
+
+static_assert(std::is_pod<BodyState>::value, "BodyState must be POD");
+
+
+/*
+ *  Calculates the position of the supplied body at the supplied
+ *  Julian date, and stores it in (and modifies) the supplied BodyState
+ *  struct.
+ *
+ *  The results are the same as those of the corresponding Planet
+ *  class, which uses the same calculation, but no objects are
+ *  created, no virtual functions are called and no strings are
+ *  allocated. The name of the body is available from body_name().
+ */
+
+void astro::compute(const BodyId body, const JulianDate& jdate,
+                    BodyState& state) {
+    RectCoords gec;
+    geo_ecl_coords(body, jdate, gec);
+
+    SphCoords sph;
+    ecl_to_sph(gec, sph);
+
+    state.body = body;
+    state.jdate = jdate.value();
+    state.right_ascension = sph.right_ascension;
+    state.declination = sph.declination;
+    state.distance = sph.distance;
+    state.geo_ecl[0] = gec.x;
+    state.geo_ecl[1] = gec.y;
+    state.geo_ecl[2] = gec.z;
+}
+
+
+/*
+ *  Calculates the position of the supplied body at the supplied
+ *  Julian date, as above.
+ */
+
+void astro::compute(const BodyId body, const double jdate,
+                    BodyState& state) {
+    compute(body, JulianDate(jdate), state);
+}
+
+
+/*
+ *  Calculates the geocentric ecliptic coordinates of the supplied
+ *  body at the supplied Julian date, and stores them in (and modifies)
+ *  the supplied RectCoords struct. Distances are in AU, or in Earth
+ *  radii for the Moon.
+ *
+ *  Each major body's calculation is an instantiation of
+ *  geo_ecl_coords<Body>(), and the Moon's is the single time
+ *  moon_geo_ecl_coords().
+ */
+
+void astro::geo_ecl_coords(const BodyId body, const JulianDate& jdate,
+                           RectCoords& gec) {
+    switch ( body ) {
+        case BODY_SUN:
+            geo_ecl_coords<BODY_SUN>(jdate, gec);
+            break;
+
+        case BODY_MERCURY:
+            geo_ecl_coords<BODY_MERCURY>(jdate, gec);
+            break;
+
+        case BODY_VENUS:
+            geo_ecl_coords<BODY_VENUS>(jdate, gec);
+            break;
+
+        case BODY_MARS:
+            geo_ecl_coords<BODY_MARS>(jdate, gec);
+            break;
+
+        case BODY_JUPITER:
+            geo_ecl_coords<BODY_JUPITER>(jdate, gec);
+            break;
+
+        case BODY_SATURN:
+            geo_ecl_coords<BODY_SATURN>(jdate, gec);
+            break;
+
+        case BODY_URANUS:
+            geo_ecl_coords<BODY_URANUS>(jdate, gec);
+            break;
+
+        case BODY_NEPTUNE:
+            geo_ecl_coords<BODY_NEPTUNE>(jdate, gec);
+            break;
+
+        case BODY_PLUTO:
+            geo_ecl_coords<BODY_PLUTO>(jdate, gec);
+            break;
+
+        case BODY_MOON:
+            moon_geo_ecl_coords(jdate, gec, 0);
+            break;
+
+        default:
+            assert(false);
+            break;
+    }
+}
+
+
+/*
+ *  Calculates the geocentric equatorial coordinates of the supplied
+ *  body at the supplied Julian date, and stores them in (and modifies)
+ *  the supplied RectCoords struct.
+ */
+
+void astro::geo_equ_coords(const BodyId body, const JulianDate& jdate,
+                           RectCoords& gqc) {
+    RectCoords gec;
+    geo_ecl_coords(body, jdate, gec);
+    ecl_to_equ(gec, gqc);
+}
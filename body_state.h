@@ -0,0 +1,47 @@
+/*
+ *  body_state.h
+ *  ============
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to BodyState value type and non-virtual position
+ *  calculations for a single body.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_BODY_STATE_H
+#define PG_ASTRO_BODY_STATE_H
+
+#include "astro_common_types.h"
+#include "julian_date.h"
+
+namespace astro {
+
+/*
+ *  The position of a body at a single time. BodyState is a POD type,
+ *  with no constructor, so that large arrays of them may be created
+ *  without initializing each element, and copied with memcpy().
+ */
+
+struct BodyState {
+    BodyId body;
+    double jdate;
+    double right_ascension;     // Degrees
+    double declination;         // Degrees
+    double distance;            // AU, or Earth radii for the Moon
+    double geo_ecl[3];          // Geocentric ecliptic x, y and z
+};
+
+void compute(const BodyId body, const JulianDate& jdate, BodyState& state);
+void compute(const BodyId body, const double jdate, BodyState& state);
+void geo_ecl_coords(const BodyId body, const JulianDate& jdate,
+                    RectCoords& gec);
+void geo_equ_coords(const BodyId body, const JulianDate& jdate,
+                    RectCoords& gqc);
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_BODY_STATE_H
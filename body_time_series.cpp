@@ -0,0 +1,238 @@
+/*
+ *  body_time_series.cpp
+ *  ====================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of BodyTimeSeries class.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <cstddef>
+#include <cassert>
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "element_tables.h"
+#include "moon.h"
+#include "body_time_series.h"
+
+using namespace astro;
+
+
+/*
+ *  Local constants
+ */
+
+namespace {
+
+//  Number of times for which geocentric ecliptic coordinates are
+//  calculated before converting them to spherical coordinates
+
+const size_t block_size = 256;
+
+}           //  namespace
+
+
+/*
+ *  Constructor.
+ *
+ *  Orbital elements of the major bodies come from the compile-time
+ *  tables in element_tables.h. Positions of the Moon are calculated
+ *  by moon_geo_ecl_coords(), in Earth radii, and the orbital elements
+ *  are unused.
+ *
+ *  Over each call to calculate() or geo_equ_coords(), the orbital
+ *  plane to ecliptic rotation matrices for the body and the Earth
+ *  are reused while their angles stay within rotation_tolerance
+ *  radians of those they were calculated for, as described for
+ *  OrbitRotation. The default of zero gives results identical to
+ *  the Planet classes, while a tolerance of, say, 1e-8 radians
+ *  changes positions by no more than a few kilometres and saves
+ *  most of the rotation's trigonometric function calls for closely
+ *  spaced times.
+ */
+
+BodyTimeSeries::BodyTimeSeries(const BodyId body,
+                               const double rotation_tolerance) :
+    m_body(body),
+    m_elements(body == BODY_MOON ? BodyElements{OrbElem(), OrbElem()} :
+                                   MAJOR_BODY_ELEMENTS[body]),
+    m_rates(element_rates(m_elements)),
+    m_earth_rates(element_rates(EARTH_ELEMENTS)),
+    m_rotation_tolerance(rotation_tolerance) {
+    assert(body >= BODY_SUN && body < NUM_BODIES);
+}
+
+
+/*
+ *  Returns the body for which positions are calculated.
+ */
+
+BodyId BodyTimeSeries::body() const {
+    return m_body;
+}
+
+
+/*
+ *  Calculates the position of the body at each of the supplied
+ *  times.
+ *
+ *  Arguments:
+ *    jdates - an array of Julian dates for which to calculate
+ *    count - the number of elements in jdates
+ *    rasc - an array of at least count elements, in which the
+ *           right ascensions, in degrees, are stored
+ *    decl - an array of at least count elements, in which the
+ *           declinations, in degrees, are stored
+ *    dist - an array of at least count elements, in which the
+ *           distances, in AU (or Earth radii for the Moon), are stored
+ *
+ *  The results are identical to those calculated by the corresponding
+ *  Planet class, but no objects are created and no virtual functions
+ *  are called for each time.
+ */
+
+void BodyTimeSeries::calculate(const double * jdates, const size_t count,
+                               double * rasc, double * decl,
+                               double * dist) const {
+    OrbitRotation rot(m_rotation_tolerance);
+    OrbitRotation earth_rot(m_rotation_tolerance);
+
+    RectCoords gec[block_size];
+
+    for ( size_t start = 0; start < count; start += block_size ) {
+        const size_t n = count - start < block_size ?
+                         count - start : block_size;
+
+        calc_geo_ecl_block(jdates + start, n, rot, earth_rot, gec);
+        ecl_to_sph(gec, n, rasc + start, decl + start, dist + start);
+    }
+}
+
+
+/*
+ *  Calculates the geocentric equatorial coordinates of the body at
+ *  each of the supplied times, and stores them in the supplied array
+ *  of at least count elements.
+ */
+
+void BodyTimeSeries::geo_equ_coords(const double * jdates,
+                                    const size_t count,
+                                    RectCoords * gqc) const {
+    OrbitRotation rot(m_rotation_tolerance);
+    OrbitRotation earth_rot(m_rotation_tolerance);
+
+    RectCoords gec[block_size];
+
+    for ( size_t start = 0; start < count; start += block_size ) {
+        const size_t n = count - start < block_size ?
+                         count - start : block_size;
+
+        calc_geo_ecl_block(jdates + start, n, rot, earth_rot, gec);
+        for ( size_t i = 0; i < n; ++i ) {
+            ecl_to_equ(gec[i], gqc[start + i]);
+        }
+    }
+}
+
+
+/*
+ *  Calculates the geocentric ecliptic position, in AU, and velocity,
+ *  in AU per day, of the body at the supplied time, and stores them
+ *  in (and modifies) the supplied RectCoords structs. For the Moon,
+ *  distances are in Earth radii.
+ *
+ *  The velocity is calculated analytically by orbital_state(), or
+ *  moon_geo_ecl_coords() for the Moon.
+ */
+
+void BodyTimeSeries::geo_ecl_state(const double jdate, RectCoords& gec,
+                                   RectCoords& gev) const {
+    if ( m_body == BODY_MOON ) {
+        moon_geo_ecl_coords(JulianDate(jdate), gec, &gev);
+        return;
+    }
+
+    const double jcents = (jdate - EPOCH_J2000) / JDAYS_PER_CENT;
+
+    const OrbElem eoes = elements_at(EARTH_ELEMENTS, jcents);
+    RectCoords eec, eev;
+    orbital_state(eoes, m_earth_rates, eec, eev);
+
+    RectCoords hec, hev;
+    if ( m_body != BODY_SUN ) {
+        const OrbElem oes = elements_at(m_elements, jcents);
+        orbital_state(oes, m_rates, hec, hev);
+    }
+
+    gec.x = hec.x - eec.x;
+    gec.y = hec.y - eec.y;
+    gec.z = hec.z - eec.z;
+    gev.x = hev.x - eev.x;
+    gev.y = hev.y - eev.y;
+    gev.z = hev.z - eev.z;
+}
+
+
+/*
+ *  Calculates the geocentric ecliptic coordinates of the body at
+ *  each of count times, up to block_size, and stores them in the
+ *  supplied array.
+ */
+
+void BodyTimeSeries::calc_geo_ecl_block(const double * jdates,
+                                        const size_t count,
+                                        OrbitRotation& rot,
+                                        OrbitRotation& earth_rot,
+                                        RectCoords * gec) const {
+    if ( m_body == BODY_MOON ) {
+        moon_geo_ecl_coords(jdates, count, gec, 0);
+        return;
+    }
+
+    for ( size_t i = 0; i < count; ++i ) {
+        calc_geo_ecl(jdates[i], rot, earth_rot, gec[i]);
+    }
+}
+
+
+/*
+ *  Calculates the geocentric ecliptic coordinates of the body at
+ *  a single time, using and updating the supplied rotations for the
+ *  body and the Earth.
+ */
+
+void BodyTimeSeries::calc_geo_ecl(const double jdate, OrbitRotation& rot,
+                                  OrbitRotation& earth_rot,
+                                  RectCoords& gec) const {
+    const double jcents = (jdate - EPOCH_J2000) / JDAYS_PER_CENT;
+
+    //  Calculate heliocentric ecliptic coordinates of the Earth
+
+    const OrbElem eoes = elements_at(EARTH_ELEMENTS, jcents);
+    RectCoords eoc, eec;
+    orbital_coords(eoes, eoc);
+    earth_rot.update(eoes);
+    earth_rot.orb_to_ecl(eoc, eec);
+
+    //  Calculate heliocentric ecliptic coordinates of the body,
+    //  which are always zero for the Sun.
+
+    RectCoords hec;
+    if ( m_body != BODY_SUN ) {
+        const OrbElem oes = elements_at(m_elements, jcents);
+        RectCoords hoc;
+        orbital_coords(oes, hoc);
+        rot.update(oes);
+        rot.orb_to_ecl(hoc, hec);
+    }
+
+    //  Convert to geocentric coordinates
+
+    gec.x = hec.x - eec.x;
+    gec.y = hec.y - eec.y;
+    gec.z = hec.z - eec.z;
+}
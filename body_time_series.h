@@ -0,0 +1,54 @@
+/*
+ *  body_time_series.h
+ *  ==================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to BodyTimeSeries class, for calculating the position
+ *  of a single body at many times.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_BODY_TIME_SERIES_H
+#define PG_ASTRO_BODY_TIME_SERIES_H
+
+#include <cstddef>
+#include "astro_common_types.h"
+#include "element_tables.h"
+#include "orbit_rotation.h"
+
+namespace astro {
+
+class BodyTimeSeries {
+    public:
+        explicit BodyTimeSeries(const BodyId body,
+                                const double rotation_tolerance = 0);
+
+        BodyId body() const;
+        void calculate(const double * jdates, const size_t count,
+                       double * rasc, double * decl, double * dist) const;
+        void geo_equ_coords(const double * jdates, const size_t count,
+                            RectCoords * gqc) const;
+        void geo_ecl_state(const double jdate, RectCoords& gec,
+                           RectCoords& gev) const;
+
+    private:
+        void calc_geo_ecl_block(const double * jdates, const size_t count,
+                                OrbitRotation& rot, OrbitRotation& earth_rot,
+                                RectCoords * gec) const;
+        void calc_geo_ecl(const double jdate, OrbitRotation& rot,
+                          OrbitRotation& earth_rot, RectCoords& gec) const;
+
+        const BodyId m_body;
+        const BodyElements m_elements;
+        const OrbElem m_rates;
+        const OrbElem m_earth_rates;
+        const double m_rotation_tolerance;
+};
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_BODY_TIME_SERIES_H
@@ -0,0 +1,317 @@
+/*
+ *  chebyshev.cpp
+ *  =============
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of ChebyshevEphemeris class.
+ *
+ *  The range of dates is divided into intervals of equal length, and
+ *  in each interval the geocentric equatorial x, y and z coordinates
+ *  of the body are each fitted with a Chebyshev series, by sampling
+ *  the body's model at the Chebyshev nodes of the interval. This is
+ *  the same approach used by JPL's DE ephemeris files.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "body_time_series.h"
+#include "chebyshev.h"
+
+using std::cos;
+using std::atan2;
+using std::sqrt;
+using std::ceil;
+
+using namespace astro;
+
+
+/*
+ *  Local function prototypes
+ */
+
+namespace {
+
+double chebyshev_sum(const double * coeffs, const int degree,
+                     const double x);
+
+}           //  namespace
+
+
+/*
+ *  Constructor.
+ *
+ *  Arguments:
+ *    body - the body to cache
+ *    start_jd - the Julian date at which the cache starts
+ *    end_jd - the Julian date at which the cache ends
+ *    interval_days - the length of each interval, in days
+ *    degree - the degree of the Chebyshev series in each interval
+ *
+ *  A degree of around 12 with intervals of 8 days gives errors
+ *  of well under an arcsecond for all the planets, and intervals of
+ *  4 days for the Moon; slower moving bodies can use much longer
+ *  intervals.
+ */
+
+ChebyshevEphemeris::ChebyshevEphemeris(const BodyId body,
+                                       const double start_jd,
+                                       const double end_jd,
+                                       const double interval_days,
+                                       const int degree) :
+    m_body(body),
+    m_start_jd(start_jd),
+    m_interval_days(interval_days),
+    m_degree(degree),
+    m_num_intervals(static_cast<int>(ceil((end_jd - start_jd) /
+                                          interval_days))),
+    m_coeffs() {
+    assert(end_jd > start_jd);
+    assert(interval_days > 0);
+    assert(degree >= 0);
+
+    const int num_nodes = degree + 1;
+    const int coeffs_per_interval = 3 * num_nodes;
+
+    m_coeffs.resize(m_num_intervals * coeffs_per_interval);
+
+    std::vector<double> node_x(num_nodes);
+    for ( int k = 0; k < num_nodes; ++k ) {
+        node_x[k] = cos(PI * (k + 0.5) / num_nodes);
+    }
+
+    const BodyTimeSeries series(body);
+    std::vector<double> jdates(num_nodes);
+    std::vector<RectCoords> gqc(num_nodes);
+
+    for ( int n = 0; n < m_num_intervals; ++n ) {
+        const double half = interval_days / 2;
+        const double mid = start_jd + n * interval_days + half;
+
+        for ( int k = 0; k < num_nodes; ++k ) {
+            jdates[k] = mid + half * node_x[k];
+        }
+
+        series.geo_equ_coords(&jdates[0], num_nodes, &gqc[0]);
+
+        double * coeffs = &m_coeffs[n * coeffs_per_interval];
+
+        for ( int j = 0; j < num_nodes; ++j ) {
+            double sum_x = 0, sum_y = 0, sum_z = 0;
+
+            for ( int k = 0; k < num_nodes; ++k ) {
+                const double t = cos(PI * j * (k + 0.5) / num_nodes);
+                sum_x += gqc[k].x * t;
+                sum_y += gqc[k].y * t;
+                sum_z += gqc[k].z * t;
+            }
+
+            coeffs[j] = 2 * sum_x / num_nodes;
+            coeffs[num_nodes + j] = 2 * sum_y / num_nodes;
+            coeffs[2 * num_nodes + j] = 2 * sum_z / num_nodes;
+        }
+    }
+}
+
+
+/*
+ *  Returns the body which is cached.
+ */
+
+BodyId ChebyshevEphemeris::body() const {
+    return m_body;
+}
+
+
+/*
+ *  Returns the Julian date at which the cache starts.
+ */
+
+double ChebyshevEphemeris::start_jd() const {
+    return m_start_jd;
+}
+
+
+/*
+ *  Returns the Julian date at which the cache ends. This may be a
+ *  little later than the end date supplied to the constructor,
+ *  since the cache always contains a whole number of intervals.
+ */
+
+double ChebyshevEphemeris::end_jd() const {
+    return m_start_jd + m_num_intervals * m_interval_days;
+}
+
+
+/*
+ *  Returns a view of the cached coefficients, which remains valid
+ *  for the lifetime of this object.
+ */
+
+ChebyshevSegment ChebyshevEphemeris::segment() const {
+    ChebyshevSegment seg;
+
+    seg.body = m_body;
+    seg.start_jd = m_start_jd;
+    seg.interval_days = m_interval_days;
+    seg.degree = m_degree;
+    seg.num_intervals = m_num_intervals;
+    seg.coeffs = &m_coeffs[0];
+
+    return seg;
+}
+
+
+/*
+ *  Calculates the geocentric equatorial coordinates of the body at
+ *  the supplied Julian date, which must be within the cache, and
+ *  stores the result in (and modifies) the supplied RectCoords struct.
+ */
+
+void ChebyshevEphemeris::geo_equ_coords(const double jdate,
+                                        RectCoords& gqc) const {
+    segment().geo_equ_coords(jdate, gqc);
+}
+
+
+/*
+ *  Calculates the right ascension, declination and distance of the
+ *  body at the supplied Julian date, which must be within the cache,
+ *  and stores the result in (and modifies) the supplied SphCoords
+ *  struct.
+ */
+
+void ChebyshevEphemeris::spherical(const double jdate,
+                                   SphCoords& sph) const {
+    RectCoords gqc;
+    geo_equ_coords(jdate, gqc);
+    rec_to_sph(gqc, sph);
+}
+
+
+/*
+ *  Returns the maximum angular error, in degrees, of the cached
+ *  positions compared to direct calculation, measured at the
+ *  specified number of evenly spaced times in each interval.
+ */
+
+double ChebyshevEphemeris::max_error(const int samples_per_interval) const {
+    assert(samples_per_interval > 0);
+
+    const int count = m_num_intervals * samples_per_interval;
+    const double step = m_interval_days / samples_per_interval;
+
+    std::vector<double> jdates(count);
+    std::vector<RectCoords> direct(count);
+
+    for ( int i = 0; i < count; ++i ) {
+        jdates[i] = m_start_jd + (i + 0.5) * step;
+    }
+
+    BodyTimeSeries(m_body).geo_equ_coords(&jdates[0], count, &direct[0]);
+
+    double max_err = 0;
+
+    for ( int i = 0; i < count; ++i ) {
+        RectCoords cached;
+        geo_equ_coords(jdates[i], cached);
+
+        const RectCoords& a = direct[i];
+        const double cx = a.y * cached.z - a.z * cached.y;
+        const double cy = a.z * cached.x - a.x * cached.z;
+        const double cz = a.x * cached.y - a.y * cached.x;
+        const double dot = a.x * cached.x + a.y * cached.y +
+                           a.z * cached.z;
+        const double err = degrees(atan2(sqrt(cx * cx + cy * cy + cz * cz),
+                                         dot));
+
+        if ( err > max_err ) {
+            max_err = err;
+        }
+    }
+
+    return max_err;
+}
+
+
+/*
+ *  Returns the Julian date at which the segment ends.
+ */
+
+double ChebyshevSegment::end_jd() const {
+    return start_jd + num_intervals * interval_days;
+}
+
+
+/*
+ *  Returns true if the segment contains the supplied Julian date.
+ */
+
+bool ChebyshevSegment::contains(const double jdate) const {
+    return jdate >= start_jd && jdate <= end_jd();
+}
+
+
+/*
+ *  Evaluates the geocentric equatorial coordinates of the body at
+ *  the supplied Julian date, which must be within the segment, and
+ *  stores the result in (and modifies) the supplied RectCoords struct.
+ */
+
+void ChebyshevSegment::geo_equ_coords(const double jdate,
+                                      RectCoords& gqc) const {
+    assert(contains(jdate));
+
+    //  Find the interval, and the position of the date within
+    //  the interval scaled to -1 <= x <= 1. The interval is clamped,
+    //  so that a date outside the segment, which is checked only in
+    //  debug builds, is extrapolated from the nearest interval rather
+    //  than reading outside the coefficients.
+
+    const double offset = (jdate - start_jd) / interval_days;
+    int n = 0;
+    if ( offset >= num_intervals ) {
+        n = num_intervals - 1;
+    } else if ( offset > 0 ) {
+        n = static_cast<int>(offset);
+    }
+
+    const double x = 2 * (offset - n) - 1;
+    const int num_nodes = degree + 1;
+    const double * icoeffs = coeffs + n * 3 * num_nodes;
+
+    gqc.x = chebyshev_sum(icoeffs, degree, x);
+    gqc.y = chebyshev_sum(icoeffs + num_nodes, degree, x);
+    gqc.z = chebyshev_sum(icoeffs + 2 * num_nodes, degree, x);
+}
+
+
+namespace {
+
+/*
+ *  Evaluates a Chebyshev series at x, using Clenshaw's recurrence.
+ *
+ *  The first coefficient is halved, as is conventional.
+ */
+
+double chebyshev_sum(const double * coeffs, const int degree,
+                     const double x) {
+    double b1 = 0, b2 = 0;
+
+    for ( int j = degree; j > 0; --j ) {
+        const double b0 = 2 * x * b1 - b2 + coeffs[j];
+        b2 = b1;
+        b1 = b0;
+    }
+
+    return x * b1 - b2 + coeffs[0] / 2;
+}
+
+}           //  namespace
@@ -0,0 +1,74 @@
+/*
+ *  chebyshev.h
+ *  ===========
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to ChebyshevEphemeris class, which caches the position
+ *  of a body over a range of dates as Chebyshev polynomials.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_CHEBYSHEV_H
+#define PG_ASTRO_CHEBYSHEV_H
+
+#include <vector>
+#include "astro_common_types.h"
+
+namespace astro {
+
+/*
+ *  A non-owning view of a block of Chebyshev coefficients for one
+ *  body. The coefficients for each interval are stored consecutively,
+ *  as degree + 1 coefficients each for x, y and z.
+ */
+
+struct ChebyshevSegment {
+    BodyId body;
+    double start_jd;
+    double interval_days;
+    int degree;
+    int num_intervals;
+    const double * coeffs;
+
+    ChebyshevSegment() :
+        body(BODY_SUN), start_jd(0), interval_days(0),
+        degree(0), num_intervals(0), coeffs(0) {}
+
+    double end_jd() const;
+    bool contains(const double jdate) const;
+    void geo_equ_coords(const double jdate, RectCoords& gqc) const;
+};
+
+class ChebyshevEphemeris {
+    public:
+        explicit ChebyshevEphemeris(const BodyId body,
+                                    const double start_jd,
+                                    const double end_jd,
+                                    const double interval_days,
+                                    const int degree);
+
+        BodyId body() const;
+        double start_jd() const;
+        double end_jd() const;
+        ChebyshevSegment segment() const;
+
+        void geo_equ_coords(const double jdate, RectCoords& gqc) const;
+        void spherical(const double jdate, SphCoords& sph) const;
+        double max_error(const int samples_per_interval) const;
+
+    private:
+        const BodyId m_body;
+        const double m_start_jd;
+        const double m_interval_days;
+        const int m_degree;
+        const int m_num_intervals;
+        std::vector<double> m_coeffs;
+};
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_CHEBYSHEV_H
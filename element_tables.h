@@ -0,0 +1,243 @@
+/*
+ *  element_tables.h
+ *  ================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Compile-time tables of the orbital elements of the major bodies,
+ *  and templated functions for evaluating their positions.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_ELEMENT_TABLES_H
+#define PG_ASTRO_ELEMENT_TABLES_H
+
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "julian_date.h"
+
+namespace astro {
+
+/*
+ *  The orbital elements of a body at J2000, and their changes per
+ *  Julian century.
+ */
+
+struct BodyElements {
+    OrbElem j2000;
+    OrbElem century;
+};
+
+
+/*
+ *  Orbital elements of the major bodies, as published by JPL with
+ *  angles in degrees, indexed by BodyId. The elements of the Sun are
+ *  all zero, since its heliocentric coordinates are always zero.
+ */
+
+constexpr BodyElements MAJOR_BODY_DEGREES[] = {
+    {OrbElem(), OrbElem()},
+    {OrbElem(0.387009927, 0.20563593, 7.00497902, 252.25032350,
+             77.45779628, 48.33076593, 0, 0),
+     OrbElem(0.00000037, 0.00001906, -0.00594749, 149472.67411175,
+             0.16047689, -0.12534081, 0, 0)},
+    {OrbElem(0.72333566, 0.00677672, 3.39467605, 181.97909950,
+             131.60246718, 76.67984255, 0, 0),
+     OrbElem(0.00000390, -0.00004107, -0.00078890, 58517.81538729,
+             0.00268329, -0.27769418, 0, 0)},
+    {OrbElem(1.52371034, 0.09339410, 1.84969142, -4.55343205,
+             -23.94362959, 49.55953891, 0, 0),
+     OrbElem(0.00001847, 0.00007882, -0.00813131, 19140.30268499,
+             0.44441088, -0.29257343, 0, 0)},
+    {OrbElem(5.20288700, 0.04838624, 1.30439695, 34.39644051,
+             14.72847983, 100.47390909, 0, 0),
+     OrbElem(-0.00011607, -0.00013253, -0.00183714, 3034.74612775,
+             0.21252668, 0.20469106, 0, 0)},
+    {OrbElem(9.53667594, 0.05386179, 2.48599187, 49.95424423,
+             92.59887831, 113.66242448, 0, 0),
+     OrbElem(-0.00125060, -0.00050991, 0.00193609, 1222.49362201,
+             -0.41897216, -0.28867794, 0, 0)},
+    {OrbElem(19.18916464, 0.04725744, 0.77263783, 313.23810451,
+             170.95427630, 74.01692503, 0, 0),
+     OrbElem(-0.00196176, -0.00004397, -0.00242939, 428.48202785,
+             0.40805281, 0.04240589, 0, 0)},
+    {OrbElem(30.06992276, 0.00859048, 1.77004347, -55.12002969,
+             44.96476227, 131.78422574, 0, 0),
+     OrbElem(0.00026291, 0.00005105, 0.00035372, 218.45945325,
+             -0.32241464, -0.00508664, 0, 0)},
+    {OrbElem(39.48211675, 0.24882730, 17.14001206, 238.92903833,
+             224.06891629, 110.30393684, 0, 0),
+     OrbElem(-0.00031596, 0.00005170, 0.00004818, 145.20780515,
+             -0.04062942, -0.01183482, 0, 0)}
+};
+
+constexpr BodyElements EARTH_DEGREES = {
+    OrbElem(1.00000261, 0.01671123, -0.00001531, 100.46457166,
+            102.93768193, 0.0, 0, 0),
+    OrbElem(0.00000562, -0.00004392, -0.01294668, 35999.37244981,
+            0.32327364, 0.0, 0, 0)
+};
+
+
+/*
+ *  Returns the supplied elements with angles converted from degrees
+ *  to radians.
+ */
+
+constexpr OrbElem elements_in_radians(const OrbElem& oes) {
+    return OrbElem(oes.sma, oes.ecc, radians(oes.inc), radians(oes.ml),
+                   radians(oes.lp), radians(oes.lan),
+                   radians(oes.man), radians(oes.arp));
+}
+
+constexpr BodyElements elements_in_radians(const BodyElements& els) {
+    return {elements_in_radians(els.j2000),
+            elements_in_radians(els.century)};
+}
+
+
+/*
+ *  The above orbital elements with angles in radians, converted at
+ *  compile time.
+ */
+
+constexpr BodyElements MAJOR_BODY_ELEMENTS[] = {
+    elements_in_radians(MAJOR_BODY_DEGREES[BODY_SUN]),
+    elements_in_radians(MAJOR_BODY_DEGREES[BODY_MERCURY]),
+    elements_in_radians(MAJOR_BODY_DEGREES[BODY_VENUS]),
+    elements_in_radians(MAJOR_BODY_DEGREES[BODY_MARS]),
+    elements_in_radians(MAJOR_BODY_DEGREES[BODY_JUPITER]),
+    elements_in_radians(MAJOR_BODY_DEGREES[BODY_SATURN]),
+    elements_in_radians(MAJOR_BODY_DEGREES[BODY_URANUS]),
+    elements_in_radians(MAJOR_BODY_DEGREES[BODY_NEPTUNE]),
+    elements_in_radians(MAJOR_BODY_DEGREES[BODY_PLUTO])
+};
+
+constexpr BodyElements EARTH_ELEMENTS = elements_in_radians(EARTH_DEGREES);
+
+
+/*
+ *  Returns the rates of change of the supplied elements per day,
+ *  for use with orbital_state().
+ */
+
+constexpr OrbElem element_rates(const BodyElements& els) {
+    return OrbElem(els.century.sma / JDAYS_PER_CENT,
+                   els.century.ecc / JDAYS_PER_CENT,
+                   els.century.inc / JDAYS_PER_CENT,
+                   els.century.ml / JDAYS_PER_CENT,
+                   els.century.lp / JDAYS_PER_CENT,
+                   els.century.lan / JDAYS_PER_CENT,
+                   els.century.ml / JDAYS_PER_CENT -
+                   els.century.lp / JDAYS_PER_CENT,
+                   els.century.lp / JDAYS_PER_CENT -
+                   els.century.lan / JDAYS_PER_CENT);
+}
+
+
+/*
+ *  Returns the orbital elements at jcents Julian centuries since
+ *  J2000, from elements with angles in radians.
+ */
+
+inline OrbElem elements_at(const BodyElements& els, const double jcents) {
+    OrbElem oes;
+    oes.sma = els.j2000.sma + els.century.sma * jcents;
+    oes.ecc = els.j2000.ecc + els.century.ecc * jcents;
+    oes.inc = els.j2000.inc + els.century.inc * jcents;
+    oes.ml = els.j2000.ml + els.century.ml * jcents;
+    oes.lp = els.j2000.lp + els.century.lp * jcents;
+    oes.lan = els.j2000.lan + els.century.lan * jcents;
+    oes.man = oes.ml - oes.lp;
+    oes.arp = oes.lp - oes.lan;
+
+    return oes;
+}
+
+
+/*
+ *  Calculates the heliocentric ecliptic coordinates at jcents Julian
+ *  centuries since J2000 of the body with the supplied elements.
+ */
+
+inline void helio_ecl_coords(const BodyElements& els, const double jcents,
+                             RectCoords& hec) {
+    const OrbElem oes = elements_at(els, jcents);
+    RectCoords hoc;
+    orbital_coords(oes, hoc);
+    orb_to_ecl(oes, hoc, hec);
+}
+
+
+/*
+ *  Calculates the heliocentric ecliptic position, in AU, and
+ *  velocity, in AU per day, at jcents Julian centuries since J2000
+ *  of the body with the supplied elements.
+ */
+
+inline void helio_ecl_state(const BodyElements& els, const double jcents,
+                            RectCoords& hec, RectCoords& hev) {
+    orbital_state(elements_at(els, jcents), element_rates(els), hec, hev);
+}
+
+
+/*
+ *  Templated evaluation of the major bodies. The body is a template
+ *  argument, so its elements are compile-time constants and the
+ *  Sun's special case is resolved when the template is instantiated,
+ *  with no objects created and no virtual functions called. Results
+ *  are the same as those of the corresponding Planet class.
+ *
+ *  The Moon is not a major body, and has moon_geo_ecl_coords().
+ */
+
+template <BodyId Body>
+inline OrbElem orbital_elements(const double jcents) {
+    static_assert(Body >= BODY_SUN && Body <= BODY_PLUTO,
+                  "Body must be a major body");
+    return elements_at(MAJOR_BODY_ELEMENTS[Body], jcents);
+}
+
+
+/*
+ *  Calculates the geocentric ecliptic coordinates, in AU, of the
+ *  body at the supplied time.
+ */
+
+template <BodyId Body>
+inline void geo_ecl_coords(const JulianDate& jdate, RectCoords& gec) {
+    static_assert(Body >= BODY_SUN && Body <= BODY_PLUTO,
+                  "Body must be a major body");
+
+    const double jcents = jdate.centuries();
+
+    RectCoords eec, hec;
+    helio_ecl_coords(EARTH_ELEMENTS, jcents, eec);
+    if ( Body != BODY_SUN ) {
+        helio_ecl_coords(MAJOR_BODY_ELEMENTS[Body], jcents, hec);
+    }
+
+    gec.x = hec.x - eec.x;
+    gec.y = hec.y - eec.y;
+    gec.z = hec.z - eec.z;
+}
+
+
+/*
+ *  Calculates the right ascension and declination, in degrees, and
+ *  the distance, in AU, of the body at the supplied time.
+ */
+
+template <BodyId Body>
+inline void evaluate(const JulianDate& jdate, SphCoords& scd) {
+    RectCoords gec;
+    geo_ecl_coords<Body>(jdate, gec);
+    ecl_to_sph(gec, scd);
+}
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_ELEMENT_TABLES_H
@@ -0,0 +1,325 @@
+/*
+ *  ephemeris_file.cpp
+ *  ==================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of binary ephemeris files.
+ *
+ *  Files are read by mapping them into memory with mmap(), and the
+ *  coefficients are evaluated directly from the mapped pages, so
+ *  opening a file takes the same time regardless of its size.
+ *  Requires a POSIX system.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "chebyshev.h"
+#include "ephemeris_file.h"
+
+using namespace astro;
+
+
+/*
+ *  File format structures and constants
+ */
+
+namespace {
+
+const char file_magic[8] = {'P', 'G', 'A', 'S', 'T', 'E', 'P', 'H'};
+const uint32_t file_endian_tag = 0x01020304;
+const uint32_t file_version = 1;
+const uint32_t max_degree = 64;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t endian_tag;
+    uint32_t version;
+    uint32_t num_segments;
+    uint32_t reserved;
+};
+
+struct SegmentHeader {
+    uint32_t body;
+    uint32_t degree;
+    uint32_t num_intervals;
+    uint32_t reserved;
+    double start_jd;
+    double interval_days;
+    uint64_t coeffs_offset;
+};
+
+size_t coeffs_size(const uint32_t degree, const uint32_t num_intervals);
+
+}           //  namespace
+
+
+/*
+ *  Writes the supplied Chebyshev segments to a binary ephemeris file.
+ *
+ *  Throws EphemerisFileException if the file cannot be written.
+ */
+
+void astro::write_ephemeris_file(const std::string& filename,
+                        const std::vector<ChebyshevSegment>& segments) {
+    FileHeader fhead;
+    std::memcpy(fhead.magic, file_magic, sizeof(fhead.magic));
+    fhead.endian_tag = file_endian_tag;
+    fhead.version = file_version;
+    fhead.num_segments = segments.size();
+    fhead.reserved = 0;
+
+    //  Build segment index, with coefficient blocks following it
+
+    std::vector<SegmentHeader> index(segments.size());
+    uint64_t offset = sizeof(FileHeader) +
+                      segments.size() * sizeof(SegmentHeader);
+
+    for ( size_t i = 0; i < segments.size(); ++i ) {
+        offset = (offset + 7) / 8 * 8;
+
+        index[i].body = segments[i].body;
+        index[i].degree = segments[i].degree;
+        index[i].num_intervals = segments[i].num_intervals;
+        index[i].reserved = 0;
+        index[i].start_jd = segments[i].start_jd;
+        index[i].interval_days = segments[i].interval_days;
+        index[i].coeffs_offset = offset;
+
+        offset += coeffs_size(index[i].degree, index[i].num_intervals);
+    }
+
+    //  Write header, index and coefficient blocks
+
+    std::ofstream out(filename.c_str(),
+                      std::ios::out | std::ios::binary | std::ios::trunc);
+    if ( !out ) {
+        throw EphemerisFileException("Couldn't open " + filename +
+                                     " for writing.");
+    }
+
+    out.write(reinterpret_cast<const char *>(&fhead), sizeof(fhead));
+    for ( size_t i = 0; i < index.size(); ++i ) {
+        out.write(reinterpret_cast<const char *>(&index[i]),
+                  sizeof(index[i]));
+    }
+
+    static const char padding[8] = {0};
+
+    for ( size_t i = 0; i < segments.size(); ++i ) {
+        const std::streamoff pad = index[i].coeffs_offset - out.tellp();
+        out.write(padding, pad);
+        out.write(reinterpret_cast<const char *>(segments[i].coeffs),
+                  coeffs_size(index[i].degree, index[i].num_intervals));
+    }
+
+    if ( !out ) {
+        throw EphemerisFileException("Couldn't write to " + filename + ".");
+    }
+}
+
+
+/*
+ *  Constructor. Maps the file into memory and validates its header
+ *  and segment index.
+ *
+ *  Throws EphemerisFileException if the file cannot be opened or
+ *  mapped, or is not a valid ephemeris file for this machine.
+ */
+
+EphemerisFile::EphemerisFile(const std::string& filename) :
+    m_data(0), m_size(0), m_segments() {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if ( fd == -1 ) {
+        throw EphemerisFileException("Couldn't open " + filename + ".");
+    }
+
+    struct stat st;
+    if ( fstat(fd, &st) == -1 ) {
+        close(fd);
+        throw EphemerisFileException("Couldn't stat " + filename + ".");
+    }
+
+    m_size = st.st_size;
+    if ( m_size < sizeof(FileHeader) ) {
+        close(fd);
+        throw EphemerisFileException(filename + " is too short.");
+    }
+
+    m_data = mmap(0, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if ( m_data == MAP_FAILED ) {
+        m_data = 0;
+        throw EphemerisFileException("Couldn't map " + filename + ".");
+    }
+
+    //  Validate the header. The destructor is not called if the
+    //  constructor throws, so unmap the file here on failure.
+
+    const char * base = static_cast<const char *>(m_data);
+    const FileHeader * fhead = reinterpret_cast<const FileHeader *>(base);
+    const char * error = 0;
+
+    if ( std::memcmp(fhead->magic, file_magic, sizeof(file_magic)) ) {
+        error = " is not an ephemeris file.";
+    } else if ( fhead->endian_tag != file_endian_tag ) {
+        error = " has the wrong byte order for this machine.";
+    } else if ( fhead->version != file_version ) {
+        error = " has an unsupported version.";
+    } else if ( (m_size - sizeof(FileHeader)) / sizeof(SegmentHeader) <
+                fhead->num_segments ) {
+        error = " has a truncated segment index.";
+    }
+
+    //  Validate the segment index, and build views of the segments
+
+    const SegmentHeader * index =
+        reinterpret_cast<const SegmentHeader *>(base + sizeof(FileHeader));
+
+    for ( uint32_t i = 0; error == 0 && i < fhead->num_segments; ++i ) {
+        const SegmentHeader& shead = index[i];
+        const size_t size = coeffs_size(shead.degree,
+                                        shead.num_intervals);
+
+        if ( shead.body >= NUM_BODIES || shead.degree > max_degree ||
+             shead.num_intervals == 0 || !(shead.interval_days > 0) ) {
+            error = " has an invalid segment.";
+        } else if ( shead.coeffs_offset % 8 != 0 ||
+                    shead.coeffs_offset > m_size ||
+                    m_size - shead.coeffs_offset < size ) {
+            error = " has a truncated coefficient block.";
+        } else {
+            ChebyshevSegment seg;
+            seg.body = static_cast<BodyId>(shead.body);
+            seg.start_jd = shead.start_jd;
+            seg.interval_days = shead.interval_days;
+            seg.degree = shead.degree;
+            seg.num_intervals = shead.num_intervals;
+            seg.coeffs = reinterpret_cast<const double *>(base +
+                                                 shead.coeffs_offset);
+            m_segments.push_back(seg);
+        }
+    }
+
+    if ( error ) {
+        munmap(m_data, m_size);
+        throw EphemerisFileException(filename + error);
+    }
+}
+
+
+/*
+ *  Destructor. Unmaps the file.
+ */
+
+EphemerisFile::~EphemerisFile() {
+    munmap(m_data, m_size);
+}
+
+
+/*
+ *  Returns the number of segments in the file.
+ */
+
+size_t EphemerisFile::num_segments() const {
+    return m_segments.size();
+}
+
+
+/*
+ *  Returns the segment with the supplied index.
+ */
+
+const ChebyshevSegment& EphemerisFile::segment(const size_t index) const {
+    return m_segments.at(index);
+}
+
+
+/*
+ *  Returns a pointer to the first segment for the supplied body which
+ *  contains the supplied Julian date, or a null pointer if there is
+ *  no such segment.
+ */
+
+const ChebyshevSegment * EphemerisFile::find_segment(const BodyId body,
+                                            const double jdate) const {
+    for ( size_t i = 0; i < m_segments.size(); ++i ) {
+        if ( m_segments[i].body == body && m_segments[i].contains(jdate) ) {
+            return &m_segments[i];
+        }
+    }
+
+    return 0;
+}
+
+
+/*
+ *  Calculates the geocentric equatorial coordinates of the supplied
+ *  body at the supplied Julian date, and stores the result in (and
+ *  modifies) the supplied RectCoords struct.
+ *
+ *  Returns false, and does not modify gqc, if the file does not
+ *  contain the body at that date.
+ */
+
+bool EphemerisFile::geo_equ_coords(const BodyId body, const double jdate,
+                                   RectCoords& gqc) const {
+    const ChebyshevSegment * seg = find_segment(body, jdate);
+    if ( seg == 0 ) {
+        return false;
+    }
+
+    seg->geo_equ_coords(jdate, gqc);
+    return true;
+}
+
+
+/*
+ *  Calculates the right ascension, declination and distance of the
+ *  supplied body at the supplied Julian date, and stores the result
+ *  in (and modifies) the supplied SphCoords struct.
+ *
+ *  Returns false, and does not modify sph, if the file does not
+ *  contain the body at that date.
+ */
+
+bool EphemerisFile::spherical(const BodyId body, const double jdate,
+                              SphCoords& sph) const {
+    RectCoords gqc;
+    if ( !geo_equ_coords(body, jdate, gqc) ) {
+        return false;
+    }
+
+    rec_to_sph(gqc, sph);
+    return true;
+}
+
+
+namespace {
+
+/*
+ *  Returns the size in bytes of a coefficient block.
+ */
+
+size_t coeffs_size(const uint32_t degree, const uint32_t num_intervals) {
+    return static_cast<size_t>(num_intervals) * 3 * (degree + 1) *
+           sizeof(double);
+}
+
+}           //  namespace
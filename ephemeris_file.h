@@ -0,0 +1,87 @@
+/*
+ *  ephemeris_file.h
+ *  ================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to binary ephemeris files, which store precomputed
+ *  Chebyshev coefficients for any number of bodies.
+ *
+ *  File format, version 1
+ *  ----------------------
+ *
+ *  All values are stored in the byte order of the machine which
+ *  wrote the file, and the endian tag in the file header allows a
+ *  reader to detect a file written with a different byte order.
+ *
+ *  File header (24 bytes):
+ *    char[8]   magic, "PGASTEPH"
+ *    uint32    endian tag, 0x01020304
+ *    uint32    format version
+ *    uint32    number of segments
+ *    uint32    reserved, zero
+ *
+ *  Segment index, one entry per segment (40 bytes each):
+ *    uint32    body, a BodyId value
+ *    uint32    degree of the Chebyshev series
+ *    uint32    number of intervals
+ *    uint32    reserved, zero
+ *    double    Julian date at start of segment
+ *    double    length of each interval, in days
+ *    uint64    offset of coefficient block from start of file
+ *
+ *  Coefficient blocks, one per segment, each starting on an 8 byte
+ *  boundary, laid out as for ChebyshevSegment.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_EPHEMERIS_FILE_H
+#define PG_ASTRO_EPHEMERIS_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include "astro_common_types.h"
+#include "chebyshev.h"
+
+namespace astro {
+
+class EphemerisFileException : public std::runtime_error {
+    public:
+        explicit EphemerisFileException(const std::string& msg) :
+            std::runtime_error(msg) {}
+};
+
+void write_ephemeris_file(const std::string& filename,
+                          const std::vector<ChebyshevSegment>& segments);
+
+class EphemerisFile {
+    public:
+        explicit EphemerisFile(const std::string& filename);
+        ~EphemerisFile();
+
+        size_t num_segments() const;
+        const ChebyshevSegment& segment(const size_t index) const;
+        const ChebyshevSegment * find_segment(const BodyId body,
+                                              const double jdate) const;
+        bool geo_equ_coords(const BodyId body, const double jdate,
+                            RectCoords& gqc) const;
+        bool spherical(const BodyId body, const double jdate,
+                       SphCoords& sph) const;
+
+    private:
+        EphemerisFile(const EphemerisFile&);
+        EphemerisFile& operator=(const EphemerisFile&);
+
+        void * m_data;
+        size_t m_size;
+        std::vector<ChebyshevSegment> m_segments;
+};
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_EPHEMERIS_FILE_H
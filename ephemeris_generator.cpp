@@ -0,0 +1,187 @@
+/*
+ *  ephemeris_generator.cpp
+ *  =======================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of multithreaded generation of positions.
+ *
+ *  Uses C++11 threads.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <cstddef>
+#include <cassert>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <system_error>
+#include "astro_common_types.h"
+#include "body_time_series.h"
+#include "ephemeris_generator.h"
+
+using namespace astro;
+
+
+/*
+ *  Local types, constants and function prototypes
+ */
+
+namespace {
+
+//  Number of times calculated by a thread at once
+
+const size_t block_size = 1024;
+
+struct GeneratorJob {
+    GeneratorJob(const double start, const double step, const size_t n,
+                 const PositionArrays * outs) :
+        start_jd(start), step_days(step), count(n), outputs(outs),
+        series(), next_block(0), mutex() {}
+    GeneratorJob(const GeneratorJob&) = delete;
+    GeneratorJob& operator=(const GeneratorJob&) = delete;
+
+    double start_jd;
+    double step_days;
+    size_t count;
+    const PositionArrays * outputs;
+    std::unique_ptr<const BodyTimeSeries> series[NUM_BODIES];
+    size_t next_block;
+    std::mutex mutex;
+};
+
+void run_generator(GeneratorJob& job);
+void join_all(std::vector<std::thread>& threads);
+bool next_block(GeneratorJob& job, size_t& first);
+
+}           //  namespace
+
+
+/*
+ *  Calculates the positions of a number of bodies at evenly spaced
+ *  times, dividing the work between a number of threads.
+ *
+ *  Arguments:
+ *    start_jd - the Julian date of the first position
+ *    step_days - the interval between positions, in days
+ *    count - the number of positions to calculate for each body
+ *    outputs - an array of NUM_BODIES PositionArrays structs, indexed
+ *              by BodyId, into which the positions are stored
+ *    num_threads - the number of threads to use, including the
+ *                  calling thread
+ *
+ *  The time of position i is always calculated as
+ *  start_jd + i * step_days, and each position is calculated in
+ *  exactly the same way whichever thread calculates it, so the
+ *  results are identical for any number of threads.
+ */
+
+void astro::generate_positions(const double start_jd,
+                               const double step_days,
+                               const size_t count,
+                               const PositionArrays outputs[NUM_BODIES],
+                               const int num_threads) {
+    assert(num_threads > 0);
+
+    //  Set up the job, with a time series for each requested body
+
+    GeneratorJob job(start_jd, step_days, count, outputs);
+
+    for ( int i = 0; i < NUM_BODIES; ++i ) {
+        if ( outputs[i].rasc ) {
+            job.series[i].reset(new BodyTimeSeries(static_cast<BodyId>(i)));
+        }
+    }
+
+    //  Start the additional threads, and have the calling thread
+    //  take its share of the work. If a thread cannot be started,
+    //  the remaining threads simply take more blocks each. Room for
+    //  the threads is reserved first, so that once a thread has
+    //  started, storing it cannot throw.
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+
+    try {
+        for ( int i = 1; i < num_threads; ++i ) {
+            threads.push_back(std::thread(run_generator, std::ref(job)));
+        }
+    } catch(std::system_error&) {
+    }
+
+    try {
+        run_generator(job);
+    } catch(...) {
+        join_all(threads);
+        throw;
+    }
+
+    join_all(threads);
+}
+
+
+namespace {
+
+/*
+ *  Calculates blocks of positions until none remain.
+ */
+
+void run_generator(GeneratorJob& job) {
+    double jdates[block_size];
+    size_t first;
+
+    while ( next_block(job, first) ) {
+        const size_t n = (job.count - first < block_size) ?
+                         job.count - first : block_size;
+
+        for ( size_t i = 0; i < n; ++i ) {
+            jdates[i] = job.start_jd + (first + i) * job.step_days;
+        }
+
+        for ( int b = 0; b < NUM_BODIES; ++b ) {
+            if ( job.series[b] ) {
+                const PositionArrays& out = job.outputs[b];
+                job.series[b]->calculate(jdates, n, out.rasc + first,
+                                         out.decl + first,
+                                         out.dist + first);
+            }
+        }
+    }
+}
+
+
+/*
+ *  Claims the next block of positions to calculate, and stores the
+ *  index of its first position in (and modifies) first.
+ *
+ *  Returns false if there are no blocks remaining.
+ */
+
+bool next_block(GeneratorJob& job, size_t& first) {
+    std::lock_guard<std::mutex> lock(job.mutex);
+
+    first = job.next_block;
+    const bool found = first < job.count;
+    if ( found ) {
+        job.next_block += block_size;
+    }
+
+    return found;
+}
+
+
+/*
+ *  Waits for each of the supplied threads to finish.
+ */
+
+void join_all(std::vector<std::thread>& threads) {
+    for ( size_t i = 0; i < threads.size(); ++i ) {
+        threads[i].join();
+    }
+}
+
+}           //  namespace
@@ -0,0 +1,45 @@
+/*
+ *  ephemeris_generator.h
+ *  =====================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to multithreaded generation of positions for many
+ *  bodies over a range of dates.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_EPHEMERIS_GENERATOR_H
+#define PG_ASTRO_EPHEMERIS_GENERATOR_H
+
+#include <cstddef>
+#include "astro_common_types.h"
+
+namespace astro {
+
+/*
+ *  Caller-supplied output arrays for one body, each of which must
+ *  have room for the requested number of positions. A body with
+ *  a null rasc pointer is skipped.
+ */
+
+struct PositionArrays {
+    double * rasc;
+    double * decl;
+    double * dist;
+
+    PositionArrays() :
+        rasc(0), decl(0), dist(0) {}
+};
+
+void generate_positions(const double start_jd, const double step_days,
+                        const size_t count,
+                        const PositionArrays outputs[NUM_BODIES],
+                        const int num_threads);
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_EPHEMERIS_GENERATOR_H
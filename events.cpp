@@ -0,0 +1,473 @@
+/*
+ *  events.cpp
+ *  ==========
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of astronomical event search functions.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <cassert>
+#include <stdint.h>
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "element_tables.h"
+#include "moon.h"
+#include "body_time_series.h"
+#include "zodiac.h"
+#include "events.h"
+
+using std::fabs;
+using std::atan2;
+
+using namespace astro;
+
+
+/*
+ *  Local constants and function prototypes
+ */
+
+namespace {
+
+//  Number of coarse search steps per zodiac sign traversed at the
+//  body's mean motion
+
+const double steps_per_sign = 8;
+
+//  Number of coarse search times calculated at a time
+
+const size_t search_block = 256;
+
+//  Tolerance, in days, to which event times are refined, and
+//  maximum number of root finding iterations
+
+const double event_tolerance = 1e-6;
+const int max_refine_iterations = 100;
+
+//  Number of coarse search steps per synodic period when searching
+//  for stations, and the step, in days, used to estimate the rate
+//  of change of the longitude rate for Newton's method
+
+const double steps_per_synodic_period = 32;
+const double newton_step = 1e-4;
+
+double rasc_at(const BodyTimeSeries& series, const double jdate);
+double boundary_offset(const BodyTimeSeries& series, const double boundary,
+                       const double jdate);
+void refine_ingress(const BodyTimeSeries& series,
+                    double t0, int s0, double t1, int s1,
+                    std::vector<ZodiacIngress>& ingresses);
+double find_boundary_crossing(const BodyTimeSeries& series,
+                              const double boundary,
+                              double t0, double t1);
+double find_station(const BodyTimeSeries& series,
+                    double t0, double f0, double t1, double f1);
+double mean_motion(const BodyId body);
+
+}           //  namespace
+
+
+/*
+ *  Finds the times at which the supplied body enters each zodiac
+ *  sign, i.e. at which its right ascension crosses a multiple of
+ *  30 degrees, between the supplied Julian dates, and appends them
+ *  to the supplied vector in time order.
+ *
+ *  The search first calculates positions at coarse steps of
+ *  ingress_search_step() days to bracket sign changes, and then
+ *  refines each one by root finding to within about 0.1 seconds,
+ *  which needs orders of magnitude fewer position calculations than
+ *  scanning at fine steps. Sign changes which happen and reverse
+ *  within a single coarse step, as can happen when a body becomes
+ *  stationary close to a sign boundary, may be missed.
+ */
+
+void astro::find_zodiac_ingresses(const BodyId body, const double start_jd,
+                                  const double end_jd,
+                                  std::vector<ZodiacIngress>& ingresses) {
+    assert(end_jd >= start_jd);
+
+    const BodyTimeSeries series(body);
+    const double step = ingress_search_step(body);
+
+    double jdates[search_block + 1];
+    double rasc[search_block + 1];
+    double decl[search_block + 1];
+    double dist[search_block + 1];
+    uint8_t signs[search_block + 1];
+
+    //  Each block of times starts with the last time of the previous
+    //  block, so that sign changes between blocks are found.
+
+    jdates[0] = start_jd;
+    rasc[0] = rasc_at(series, start_jd);
+    classify_zodiac(rasc, signs, 0, 1);
+
+    size_t done = 0;
+    bool finished = start_jd >= end_jd;
+    while ( !finished ) {
+        size_t n = 0;
+        while ( n < search_block && !finished ) {
+            ++n;
+            jdates[n] = start_jd + (done + n) * step;
+            if ( jdates[n] >= end_jd ) {
+                jdates[n] = end_jd;
+                finished = true;
+            }
+        }
+
+        series.calculate(jdates + 1, n, rasc + 1, decl + 1, dist + 1);
+        classify_zodiac(rasc + 1, signs + 1, 0, n);
+
+        for ( size_t i = 1; i <= n; ++i ) {
+            if ( signs[i] != signs[i - 1] ) {
+                refine_ingress(series, jdates[i - 1], signs[i - 1],
+                               jdates[i], signs[i], ingresses);
+            }
+        }
+
+        done += n;
+        jdates[0] = jdates[n];
+        rasc[0] = rasc[n];
+        signs[0] = signs[n];
+    }
+}
+
+
+/*
+ *  Returns the coarse step, in days, used by find_zodiac_ingresses()
+ *  for the supplied body.
+ *
+ *  This is sized from the mean motion of the body's mean longitude
+ *  in its century rates, or from that of the Earth if it is faster,
+ *  since the Earth's orbital motion dominates the apparent geocentric
+ *  motion of the outer planets and the Sun.
+ */
+
+double astro::ingress_search_step(const BodyId body) {
+    const double earth_rate = mean_motion(BODY_SUN);
+    const double body_rate = mean_motion(body);
+    const double rate = body_rate > earth_rate ? body_rate : earth_rate;
+
+    return 30 / rate / steps_per_sign;
+}
+
+
+/*
+ *  Finds the times between the supplied Julian dates at which the
+ *  geocentric ecliptic longitude of the supplied body is stationary,
+ *  i.e. at which the body turns retrograde or direct, and appends
+ *  them to the supplied vector in time order.
+ *
+ *  The longitude rate is calculated analytically from the orbital
+ *  velocities of the body and the Earth, and sampled at coarse steps
+ *  of station_search_step() days to bracket the stations, each of
+ *  which is then refined to within about 0.1 seconds by Newton's
+ *  method in a few iterations.
+ *
+ *  The Sun and the Moon have no stations.
+ */
+
+void astro::find_stations(const BodyId body, const double start_jd,
+                          const double end_jd,
+                          std::vector<Station>& stations) {
+    assert(end_jd >= start_jd);
+
+    if ( body == BODY_SUN || body == BODY_MOON ) {
+        return;
+    }
+
+    const BodyTimeSeries series(body);
+    const double step = station_search_step(body);
+
+    double t0 = start_jd;
+    double f0 = longitude_rate(series, t0);
+
+    for ( long i = 1; t0 < end_jd; ++i ) {
+        double t1 = start_jd + i * step;
+        if ( t1 > end_jd ) {
+            t1 = end_jd;
+        }
+        const double f1 = longitude_rate(series, t1);
+
+        if ( (f0 < 0) != (f1 < 0) ) {
+            Station station;
+            station.body = body;
+            station.jdate = find_station(series, t0, f0, t1, f1);
+            station.retrograde = f1 < 0;
+
+            RectCoords gec, gev;
+            series.geo_ecl_state(station.jdate, gec, gev);
+            station.longitude = normalize_degrees(degrees(atan2(gec.y,
+                                                                gec.x)));
+            stations.push_back(station);
+        }
+
+        t0 = t1;
+        f0 = f1;
+    }
+}
+
+
+/*
+ *  Divides the period between the supplied Julian dates into
+ *  intervals of direct and retrograde motion of the supplied body,
+ *  separated by its stations, and appends them to the supplied
+ *  vector in time order.
+ */
+
+void astro::find_motion_intervals(const BodyId body, const double start_jd,
+                                  const double end_jd,
+                                  std::vector<MotionInterval>& intervals) {
+    std::vector<Station> stations;
+    find_stations(body, start_jd, end_jd, stations);
+
+    MotionInterval interval;
+    interval.body = body;
+    interval.start_jd = start_jd;
+    interval.retrograde = longitude_rate(BodyTimeSeries(body), start_jd) < 0;
+
+    for ( size_t i = 0; i < stations.size(); ++i ) {
+        interval.end_jd = stations[i].jdate;
+        intervals.push_back(interval);
+
+        interval.start_jd = stations[i].jdate;
+        interval.retrograde = stations[i].retrograde;
+    }
+
+    interval.end_jd = end_jd;
+    intervals.push_back(interval);
+}
+
+
+/*
+ *  Returns the coarse step, in days, used by find_stations() for the
+ *  supplied body.
+ *
+ *  This is sized from the body's synodic period, calculated from the
+ *  mean motions of the body and the Earth in their century rates.
+ *  A body is retrograde for at least about a fifth of its synodic
+ *  period, so no retrograde interval can fall between two steps.
+ */
+
+double astro::station_search_step(const BodyId body) {
+    assert(body != BODY_SUN && body != BODY_MOON);
+
+    const double synodic_period = 360 / fabs(mean_motion(body) -
+                                             mean_motion(BODY_SUN));
+    return synodic_period / steps_per_synodic_period;
+}
+
+
+/*
+ *  Returns the rate of change of the geocentric ecliptic longitude
+ *  of the body, in degrees per day, at the supplied time.
+ */
+
+double astro::longitude_rate(const BodyTimeSeries& series,
+                             const double jdate) {
+    RectCoords gec, gev;
+    series.geo_ecl_state(jdate, gec, gev);
+
+    return degrees((gec.x * gev.y - gec.y * gev.x) /
+                   (gec.x * gec.x + gec.y * gec.y));
+}
+
+
+namespace {
+
+/*
+ *  Returns the mean motion of the supplied body, in degrees per day,
+ *  from the rate of its mean longitude in its century elements, or
+ *  daily elements for the Moon. The Sun's apparent mean motion is
+ *  that of the Earth.
+ */
+
+double mean_motion(const BodyId body) {
+    if ( body == BODY_MOON ) {
+        return fabs(Moon::day_elements.ml);
+    }
+
+    const BodyElements& els = body == BODY_SUN ?
+                              EARTH_DEGREES : MAJOR_BODY_DEGREES[body];
+    return fabs(els.century.ml) / JDAYS_PER_CENT;
+}
+
+
+/*
+ *  Returns the right ascension of the body at the supplied time.
+ */
+
+double rasc_at(const BodyTimeSeries& series, const double jdate) {
+    double rasc, decl, dist;
+    series.calculate(&jdate, 1, &rasc, &decl, &dist);
+    return rasc;
+}
+
+
+/*
+ *  Returns the angular distance, in degrees in the range -180 to
+ *  180, by which the right ascension of the body is past the
+ *  supplied boundary at the supplied time.
+ */
+
+double boundary_offset(const BodyTimeSeries& series, const double boundary,
+                       const double jdate) {
+    const double d = normalize_degrees(rasc_at(series, jdate) - boundary);
+    return d > 180 ? d - 360 : d;
+}
+
+
+/*
+ *  Finds the ingresses between times t0 and t1, at which the body
+ *  is in signs s0 and s1 respectively, and appends them to the
+ *  supplied vector in time order.
+ *
+ *  If the signs are adjacent, the single boundary crossing is found
+ *  by root finding. Otherwise the interval is bisected until they
+ *  are.
+ */
+
+void refine_ingress(const BodyTimeSeries& series,
+                    double t0, int s0, double t1, int s1,
+                    std::vector<ZodiacIngress>& ingresses) {
+    if ( s0 == s1 ) {
+        return;
+    }
+
+    const bool forward = (s1 == (s0 + 1) % NUM_ZODIAC_SIGNS);
+    const bool backward = (s0 == (s1 + 1) % NUM_ZODIAC_SIGNS);
+
+    if ( !forward && !backward && t1 - t0 > event_tolerance ) {
+        const double tm = (t0 + t1) / 2;
+        uint8_t sm;
+        const double rm = rasc_at(series, tm);
+        classify_zodiac(&rm, &sm, 0, 1);
+
+        refine_ingress(series, t0, s0, tm, sm, ingresses);
+        refine_ingress(series, tm, sm, t1, s1, ingresses);
+        return;
+    }
+
+    ZodiacIngress ingress;
+    ingress.body = series.body();
+    ingress.sign_index = s1;
+    ingress.retrograde = backward;
+
+    if ( forward || backward ) {
+        const double boundary = 30.0 * (forward ? s1 : s0);
+        ingress.jdate = find_boundary_crossing(series, boundary, t0, t1);
+    } else {
+        ingress.jdate = (t0 + t1) / 2;
+    }
+
+    ingresses.push_back(ingress);
+}
+
+
+/*
+ *  Returns the time between t0 and t1 at which the right ascension
+ *  of the body crosses the supplied boundary, given that it lies on
+ *  different sides of it at those times.
+ *
+ *  Uses the Illinois variant of the method of false position, which
+ *  converges superlinearly but, unlike the secant method, always
+ *  keeps the root bracketed.
+ */
+
+double find_boundary_crossing(const BodyTimeSeries& series,
+                              const double boundary,
+                              double t0, double t1) {
+
+    double f0 = boundary_offset(series, boundary, t0);
+    double f1 = boundary_offset(series, boundary, t1);
+    int side = 0;
+
+    for ( int i = 0; i < max_refine_iterations &&
+                     t1 - t0 > event_tolerance; ++i ) {
+        const double t = (f1 == f0) ? (t0 + t1) / 2 :
+                                      t1 - f1 * (t1 - t0) / (f1 - f0);
+        const double f = boundary_offset(series, boundary, t);
+
+        if ( f == 0 ) {
+            return t;
+        } else if ( (f < 0) == (f0 < 0) ) {
+            t0 = t;
+            f0 = f;
+            if ( side == -1 ) {
+                f1 /= 2;
+            }
+            side = -1;
+        } else {
+            t1 = t;
+            f1 = f;
+            if ( side == 1 ) {
+                f0 /= 2;
+            }
+            side = 1;
+        }
+
+        //  Stop once the estimate is within tolerance of the root
+
+        if ( fabs(f) < 1e-9 ) {
+            return t;
+        }
+    }
+
+    return (t0 + t1) / 2;
+}
+
+
+/*
+ *  Returns the time between t0 and t1 at which the longitude rate of
+ *  the body, which is f0 and f1 at those times and has different
+ *  signs at each, is zero.
+ *
+ *  Uses Newton's method, with the rate of change of the analytic
+ *  longitude rate estimated from a second evaluation a short step
+ *  away. Steps falling outside the bracketing interval, which is
+ *  narrowed at each iteration, are replaced by bisection.
+ */
+
+double find_station(const BodyTimeSeries& series,
+                    double t0, double f0, double t1, double f1) {
+    double t = t0 - f0 * (t1 - t0) / (f1 - f0);
+
+    for ( int i = 0; i < max_refine_iterations; ++i ) {
+        const double f = longitude_rate(series, t);
+        if ( f == 0 ) {
+            return t;
+        }
+
+        if ( (f < 0) == (f0 < 0) ) {
+            t0 = t;
+            f0 = f;
+        } else {
+            t1 = t;
+            f1 = f;
+        }
+
+        const double df = (longitude_rate(series, t + newton_step) - f) /
+                          newton_step;
+        double next = (t0 + t1) / 2;
+        if ( df != 0 && t - f / df > t0 && t - f / df < t1 ) {
+            next = t - f / df;
+        }
+
+        if ( fabs(next - t) < event_tolerance ) {
+            return next;
+        }
+        t = next;
+    }
+
+    return t;
+}
+
+}           //  namespace
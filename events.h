@@ -0,0 +1,67 @@
+/*
+ *  events.h
+ *  ========
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to astronomical event search functions.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_EVENTS_H
+#define PG_ASTRO_EVENTS_H
+
+#include <vector>
+#include "astro_common_types.h"
+#include "body_time_series.h"
+
+namespace astro {
+
+struct ZodiacIngress {
+    BodyId body;
+    double jdate;           // Julian date of the ingress
+    int sign_index;         // Index of the sign entered
+    bool retrograde;        // True if entered moving backwards
+
+    ZodiacIngress() :
+        body(BODY_SUN), jdate(0), sign_index(0), retrograde(false) {}
+};
+
+struct Station {
+    BodyId body;
+    double jdate;           // Julian date of the station
+    double longitude;       // Geocentric ecliptic longitude, degrees
+    bool retrograde;        // True if the body turns retrograde
+
+    Station() :
+        body(BODY_SUN), jdate(0), longitude(0), retrograde(false) {}
+};
+
+struct MotionInterval {
+    BodyId body;
+    double start_jd;
+    double end_jd;
+    bool retrograde;        // True if the body is retrograde
+
+    MotionInterval() :
+        body(BODY_SUN), start_jd(0), end_jd(0), retrograde(false) {}
+};
+
+void find_zodiac_ingresses(const BodyId body, const double start_jd,
+                           const double end_jd,
+                           std::vector<ZodiacIngress>& ingresses);
+double ingress_search_step(const BodyId body);
+void find_stations(const BodyId body, const double start_jd,
+                   const double end_jd, std::vector<Station>& stations);
+void find_motion_intervals(const BodyId body, const double start_jd,
+                           const double end_jd,
+                           std::vector<MotionInterval>& intervals);
+double station_search_step(const BodyId body);
+double longitude_rate(const BodyTimeSeries& series, const double jdate);
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_EVENTS_H
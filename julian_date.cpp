@@ -0,0 +1,91 @@
+/*
+ *  julian_date.cpp
+ *  ===============
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of conversions from Unix time to Julian dates.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <cstddef>
+#include <cmath>
+#include <stdint.h>
+#include <paulgrif/utctime.h>
+#include "julian_date.h"
+
+using namespace astro;
+
+
+/*
+ *  Local constants
+ */
+
+namespace {
+
+const int64_t secs_in_a_day = 86400;
+
+}           //  namespace
+
+
+/*
+ *  Returns the Julian date of the supplied number of seconds since
+ *  the Unix epoch, ignoring leap seconds as Unix time does.
+ */
+
+JulianDate astro::julian_date_from_unix(const int64_t secs) {
+    int64_t days = secs / secs_in_a_day;
+    int64_t rem = secs % secs_in_a_day;
+    if ( rem < 0 ) {
+        rem += secs_in_a_day;
+        --days;
+    }
+
+    return JulianDate(EPOCH_UNIX + days,
+                      static_cast<double>(rem) / secs_in_a_day);
+}
+
+
+/*
+ *  Converts an array of times in seconds since the Unix epoch to
+ *  Julian dates, for passing to the batch functions.
+ *
+ *  Arguments:
+ *    secs - an array of times, in seconds since the Unix epoch
+ *    count - the number of elements in secs
+ *    jdates - an array of at least count elements, in which the
+ *             Julian dates are stored
+ *
+ *  The results are identical to those of julian_date() for a
+ *  UTCTime with the same timestamp.
+ */
+
+void astro::julian_dates_from_unix(const int64_t * secs, const size_t count,
+                                   double * jdates) {
+    for ( size_t i = 0; i < count; ++i ) {
+        jdates[i] = EPOCH_UNIX +
+                    static_cast<double>(secs[i]) / secs_in_a_day;
+    }
+}
+
+
+/*
+ *  Returns the Julian date of the supplied UTC time.
+ */
+
+JulianDate astro::julian_date_split(const utctime::UTCTime& utc_time) {
+    return julian_date_from_unix(utc_time.timestamp());
+}
+
+
+/*
+ *  Returns the supplied Julian date as a number of seconds since the
+ *  Unix epoch, rounded to the nearest second.
+ */
+
+int64_t astro::unix_seconds(const JulianDate& jdate) {
+    return std::llround(jdate.days_since(EPOCH_UNIX) * secs_in_a_day);
+}
@@ -0,0 +1,76 @@
+/*
+ *  julian_date.h
+ *  =============
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to JulianDate time type and conversions from Unix time.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_JULIAN_DATE_H
+#define PG_ASTRO_JULIAN_DATE_H
+
+#include <cstddef>
+#include <stdint.h>
+#include <paulgrif/utctime.h>
+#include "astrofunc.h"
+
+namespace astro {
+
+/*
+ *  Constants
+ */
+
+constexpr double EPOCH_UNIX = 2440587.5;    //  1970-01-01 00:00 UTC
+
+
+/*
+ *  A Julian date, held as a day and a fraction of a day whose sum is
+ *  the date. Dates converted from Unix time keep a day ending in .5
+ *  (i.e. midnight UTC) and the time of day in the fraction, so that
+ *  differences from an epoch lose no precision to the size of the
+ *  date, but any split between the two parts is valid.
+ */
+
+struct JulianDate {
+    double day;
+    double fraction;
+
+    JulianDate() :
+        day(EPOCH_J2000), fraction(0) {}
+    explicit JulianDate(const double jdate) :
+        day(jdate), fraction(0) {}
+    JulianDate(const double d, const double f) :
+        day(d), fraction(f) {}
+
+    double value() const {
+        return day + fraction;
+    }
+
+    double days_since(const double epoch) const {
+        return (day - epoch) + fraction;
+    }
+
+    double centuries() const {
+        return days_since(EPOCH_J2000) / JDAYS_PER_CENT;
+    }
+};
+
+
+/*
+ *  Function prototypes
+ */
+
+JulianDate julian_date_from_unix(const int64_t secs);
+void julian_dates_from_unix(const int64_t * secs, const size_t count,
+                            double * jdates);
+JulianDate julian_date_split(const utctime::UTCTime& utc_time);
+int64_t unix_seconds(const JulianDate& jdate);
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_JULIAN_DATE_H
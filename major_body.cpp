@@ -12,11 +12,10 @@
  */
 
 
-#include <paulgrif/utctime.h>
 #include "astro_common_types.h"
 #include "astrofunc.h"
+#include "element_tables.h"
 #include "major_body.h"
-#include "planets.h"
 
 using namespace astro;
 
@@ -29,50 +28,30 @@ MajorBody::~MajorBody() {}
 
 
 /*
- *  Returns orbital elements for the specified time.
- *
- *  Arguments:
- *    calc_time - a UTCTime class containing the time for which to
- *                calculate
- *    j2000_oes - an OrbElem struct representing the actual orbital
- *                elements at J2000
- *    century_oes - an OrbElem struct representing the changes in orbital
- *                  elements per Julian century.
+ *  Calculates the planet's geocentric ecliptic coordinates.
  *
- *  Returns:
- *    An OrbElem struct containing the orbital elements for the
- *    specified time.
+ *  The planet's own coordinates come from the elements calculated
+ *  when it was constructed, and the Earth's from its element table,
+ *  by the same steps as geo_ecl_coords<Body>(), so the results are
+ *  identical to those of compute().
  */
 
-OrbElem
-MajorBody::calc_orbital_elements(const utctime::UTCTime& calc_time,
-                                 const OrbElem& j2000_oes,
-                                 const OrbElem& century_oes) const {
-    static const double epoch_j2000 = 2451545;
-    static const double jdays_per_cent = 36525;
-    const double jcents = (julian_date(calc_time) - epoch_j2000) /
-                          jdays_per_cent;
-
-    OrbElem oes;
-    oes.sma = j2000_oes.sma + century_oes.sma * jcents;
-    oes.ecc = j2000_oes.ecc + century_oes.ecc * jcents;
-    oes.inc = radians(j2000_oes.inc + century_oes.inc * jcents);
-    oes.ml = radians(j2000_oes.ml + century_oes.ml * jcents);
-    oes.lp = radians(j2000_oes.lp + century_oes.lp * jcents);
-    oes.lan = radians(j2000_oes.lan + century_oes.lan * jcents);
-    oes.man = oes.ml - oes.lp;
-    oes.arp = oes.lp - oes.lan;
-
-    return oes;
+RectCoords MajorBody::geo_ecl_coords() const {
+    RectCoords eec;
+    astro::helio_ecl_coords(EARTH_ELEMENTS, get_jdate().centuries(), eec);
+    return geo_ecl_coords_from_earth(eec);
 }
 
 
 /*
- *  Calculates the planet's geocentric ecliptic coordinates.
+ *  Calculates the planet's geocentric ecliptic coordinates, given
+ *  the already-calculated heliocentric ecliptic coordinates of
+ *  the Earth at the same time. Used when calculating positions for
+ *  several planets at once, so that the Earth need only be
+ *  calculated once.
  */
 
-RectCoords MajorBody::geo_ecl_coords() const {
-    const RectCoords eec = Earth(get_calc_time()).helio_ecl_coords();
+RectCoords MajorBody::geo_ecl_coords_from_earth(const RectCoords& eec) const {
     const RectCoords hec = helio_ecl_coords();
 
     RectCoords gec;
@@ -83,3 +62,43 @@ RectCoords MajorBody::geo_ecl_coords() const {
 
     return gec;
 }
+
+
+/*
+ *  Calculates the planet's geocentric ecliptic position, in AU, and
+ *  velocity, in AU per day.
+ *
+ *  Both are calculated together, from a single solution of Kepler's
+ *  equation for each of the planet and the Earth.
+ */
+
+StateVector MajorBody::state() const {
+    const StateVector hes = helio_ecl_state();
+    StateVector ees;
+    astro::helio_ecl_state(EARTH_ELEMENTS, get_jdate().centuries(),
+                           ees.position, ees.velocity);
+
+    StateVector ges;
+    ges.position.x = hes.position.x - ees.position.x;
+    ges.position.y = hes.position.y - ees.position.y;
+    ges.position.z = hes.position.z - ees.position.z;
+    ges.velocity.x = hes.velocity.x - ees.velocity.x;
+    ges.velocity.y = hes.velocity.y - ees.velocity.y;
+    ges.velocity.z = hes.velocity.z - ees.velocity.z;
+
+    return ges;
+}
+
+
+/*
+ *  Calculates the planet's heliocentric ecliptic position, in AU,
+ *  and velocity, in AU per day.
+ */
+
+StateVector MajorBody::helio_ecl_state() const {
+    StateVector hes;
+    orbital_state(get_orbital_elements(), m_rates,
+                  hes.position, hes.velocity);
+
+    return hes;
+}
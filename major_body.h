@@ -15,26 +15,34 @@
 #ifndef PG_ASTRO_MAJOR_BODY_H
 #define PG_ASTRO_MAJOR_BODY_H
 
-#include <paulgrif/utctime.h>
 #include "astro_common_types.h"
+#include "astrofunc.h"
+#include "julian_date.h"
+#include "element_tables.h"
 #include "planet.h"
 
 namespace astro {
 
 class MajorBody : public Planet {
     public:
-        explicit MajorBody(const utctime::UTCTime& ct,
-                           const OrbElem& j2000_oes,
-                           const OrbElem& century_oes) :
-            Planet(ct, calc_orbital_elements(ct, j2000_oes, century_oes)) {}
+        explicit MajorBody(const JulianDate& jdate, const BodyId body) :
+            MajorBody(jdate, MAJOR_BODY_ELEMENTS[body]) {}
+
+        //  For the Earth, which has no BodyId
+
+        explicit MajorBody(const JulianDate& jdate,
+                           const BodyElements& elements) :
+            Planet(jdate, elements_at(elements, jdate.centuries())),
+            m_rates(element_rates(elements)) {}
         virtual ~MajorBody() = 0;
 
         virtual RectCoords geo_ecl_coords() const;
+        RectCoords geo_ecl_coords_from_earth(const RectCoords& eec) const;
+        virtual StateVector state() const;
+        StateVector helio_ecl_state() const;
 
     private:
-        OrbElem calc_orbital_elements(const utctime::UTCTime& ct,
-                                      const OrbElem& j2000_oes,
-                                      const OrbElem& century_oes) const;
+        const OrbElem m_rates;
 };
 
 }           //  namespace astro
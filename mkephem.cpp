@@ -0,0 +1,76 @@
+/*
+ *  mkephem.cpp
+ *  ===========
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Tool to generate a binary ephemeris file for all the major
+ *  bodies over a range of Julian dates.
+ *
+ *  Usage: mkephem filename start_jd end_jd
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "chebyshev.h"
+#include "ephemeris_file.h"
+
+using namespace astro;
+
+
+int main(int argc, char ** argv) {
+
+    //  Interval lengths, in days, for each body, chosen so that
+    //  the cached positions are accurate to well under an arcsecond
+    //  with series of degree 12.
+
+    static const double interval_days[] = {
+        32, 8, 16, 16, 32, 32, 64, 64, 64, 4
+    };
+    static const int degree = 12;
+
+    if ( argc != 4 ) {
+        std::cerr << "Usage: mkephem filename start_jd end_jd"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const double start_jd = std::atof(argv[2]);
+    const double end_jd = std::atof(argv[3]);
+
+    if ( !(end_jd > start_jd) ) {
+        std::cerr << "mkephem: end_jd must be after start_jd" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<ChebyshevEphemeris *> caches;
+    std::vector<ChebyshevSegment> segments;
+
+    for ( int i = BODY_SUN; i < NUM_BODIES; ++i ) {
+        caches.push_back(new ChebyshevEphemeris(static_cast<BodyId>(i),
+                                                start_jd, end_jd,
+                                                interval_days[i], degree));
+        segments.push_back(caches.back()->segment());
+    }
+
+    int status = EXIT_SUCCESS;
+
+    try {
+        write_ephemeris_file(argv[1], segments);
+    } catch(EphemerisFileException& e) {
+        std::cerr << "mkephem: " << e.what() << std::endl;
+        status = EXIT_FAILURE;
+    }
+
+    for ( size_t i = 0; i < caches.size(); ++i ) {
+        delete caches[i];
+    }
+
+    return status;
+}
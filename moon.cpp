@@ -13,9 +13,12 @@
 
 #include <string>
 #include <cmath>
-#include <paulgrif/utctime.h>
+#include <cstddef>
+#include <cassert>
+#include <cstdlib>
 #include "astro_common_types.h"
 #include "astrofunc.h"
+#include "julian_date.h"
 #include "planet.h"
 #include "moon.h"
 
@@ -23,11 +26,133 @@ using std::cos;
 using std::sin;
 using std::atan2;
 using std::sqrt;
-using std::pow;
+using std::abs;
 
 using namespace astro;
 
 
+/*
+ *  Local types, constants and function prototypes
+ */
+
+namespace {
+
+const double epoch_y2000 = 2451543.5;     //  1999-12-31 00:00 UTC
+
+//  Number of times for which moon_geo_ecl_coords() evaluates the
+//  perturbations together, which is enough for the sums to vectorize.
+//  Single times are evaluated by a separate instantiation of the same
+//  kernel, so that they pay for neither the block's working arrays
+//  nor its loops.
+
+const size_t moon_block_size = 8;
+
+//  Largest multiplier of any angle in the perturbation tables. The
+//  sines and cosines of the multiples of each angle up to this one
+//  are generated from those of the angle itself by the angle
+//  addition formulae, so terms may be added to the tables at the
+//  cost of a few multiplications each, and larger multipliers at the
+//  cost of one more step of the recurrence.
+
+const int max_multiple = 4;
+
+//  Angles from which the arguments of the perturbation terms are
+//  formed
+
+enum MoonArgument {
+    ARG_MAN,            //  Moon's mean anomaly
+    ARG_SUN_MAN,        //  Sun's mean anomaly
+    ARG_MEL,            //  Moon's mean elongation
+    ARG_ARL,            //  Moon's argument of latitude
+    ARG_ML,             //  Moon's mean longitude
+    NUM_MOON_ARGS
+};
+
+//  A perturbation term is its coefficient multiplied by the sine
+//  (or cosine) of the sum of the angles times their multipliers
+
+struct PerturbationTerm {
+    double coeff;
+    int multipliers[NUM_MOON_ARGS];
+};
+
+//  Longitude perturbations, in degrees
+
+const PerturbationTerm lon_terms[] = {
+    {-1.274, {1, 0, -2, 0, 0}},
+    {0.658, {0, 0, 2, 0, 0}},
+    {-0.186, {0, 1, 0, 0, 0}},
+    {-0.059, {2, 0, -2, 0, 0}},
+    {-0.057, {1, 1, -2, 0, 0}},
+    {0.053, {1, 0, 2, 0, 0}},
+    {0.046, {0, -1, 0, 0, 2}},
+    {0.041, {1, -1, 0, 0, 0}},
+    {-0.035, {0, 0, 0, 0, 1}},
+    {-0.031, {1, 1, 0, 0, 0}},
+    {-0.015, {0, 0, -2, 2, 0}},
+    {0.011, {1, 0, -4, 0, 0}}
+};
+
+//  Latitude perturbations, in degrees
+
+const PerturbationTerm lat_terms[] = {
+    {-0.173, {0, 0, -2, 1, 0}},
+    {-0.055, {1, 0, -2, -1, 0}},
+    {-0.046, {1, 0, -2, 1, 0}},
+    {0.033, {0, 0, 2, 1, 0}},
+    {0.017, {2, 0, 0, 1, 0}}
+};
+
+//  Distance perturbations, in Earth radii, using cosines
+
+const PerturbationTerm dist_terms[] = {
+    {-0.58, {1, 0, -2, 0, 0}},
+    {-0.46, {0, 0, 2, 0, 0}}
+};
+
+//  Cosines and sines of the multiples of each angle, for a block
+//  of Lanes times
+
+template <size_t Lanes>
+struct MultipleAngles {
+    double cos_m[NUM_MOON_ARGS][max_multiple + 1][Lanes];
+    double sin_m[NUM_MOON_ARGS][max_multiple + 1][Lanes];
+};
+
+template <size_t Lanes>
+void moon_block(const OrbElem * oes, const OrbElem& rates,
+                const double * days, RectCoords * gec, RectCoords * gev);
+template <size_t Lanes>
+void calc_multiple_angles(const double args[][Lanes],
+                          MultipleAngles<Lanes>& angles);
+template <size_t Lanes>
+void sum_terms(const PerturbationTerm * terms, const size_t num_terms,
+               const MultipleAngles<Lanes>& angles,
+               const double * arg_rates, const bool cosine,
+               double * sum, double * rate);
+
+}           //  namespace
+
+
+/*
+ *  Define static data members.
+ */
+
+const OrbElem Moon::y2000_elements(60.2666, 0.0549,
+                                   5.1454, 198.5516,
+                                   83.1862, 125.1228, 0, 0);
+const OrbElem Moon::day_elements(0, 0,
+                                 0, 13.1763964649,
+                                 0.111403514, -0.0529538083, 0, 0);
+
+const OrbElem SunForMoon::y2000_elements(1, 0.016709,
+                                         0, 278.9874,
+                                         -77.0596, 0, 0, 0);
+const OrbElem SunForMoon::day_elements(0, -0.000000001151,
+                                       0, 0.98564735200,
+                                       0.00004709350, 0, 0, 0);
+
+
 /*
  *  Provide definition of pure virtual destructor.
  */
@@ -36,16 +161,23 @@ MoonBase::~MoonBase() {}
 
 
 /*
- *  Returns orbital elements for the specified time.
+ *  Returns the number of days since the epoch of the orbital
+ *  elements, 1999-12-31 00:00 UTC.
  */
 
-OrbElem MoonBase::calc_orbital_elements(const utctime::UTCTime& calc_time,
-                                        const OrbElem& y2000_oes,
-                                        const OrbElem& day_oes) const {
-    static const utctime::UTCTime utc_y2000(1999, 12, 31, 0, 0, 0);
-    static const double secs_in_a_day = 86400;
-    const double days = (calc_time - utc_y2000) / secs_in_a_day;
+double MoonBase::days_since_y2000(const JulianDate& jdate) {
+    return jdate.days_since(epoch_y2000);
+}
+
 
+/*
+ *  Returns orbital elements for the specified number of days since
+ *  the epoch of the elements.
+ */
+
+OrbElem MoonBase::calc_orbital_elements(const double days,
+                                        const OrbElem& y2000_oes,
+                                        const OrbElem& day_oes) {
     OrbElem oes;
 
     oes.sma = y2000_oes.sma + day_oes.sma * days;
@@ -61,77 +193,360 @@ OrbElem MoonBase::calc_orbital_elements(const utctime::UTCTime& calc_time,
 }
 
 
+/*
+ *  Returns the rates of change of the orbital elements per day,
+ *  with angles in radians, for use with orbital_state().
+ */
+
+OrbElem MoonBase::calc_element_rates(const OrbElem& day_oes) {
+    OrbElem rates;
+
+    rates.sma = day_oes.sma;
+    rates.ecc = day_oes.ecc;
+    rates.inc = radians(day_oes.inc);
+    rates.ml = radians(day_oes.ml);
+    rates.lp = radians(day_oes.lp);
+    rates.lan = radians(day_oes.lan);
+    rates.man = rates.ml - rates.lp;
+    rates.arp = rates.lp - rates.lan;
+
+    return rates;
+}
+
+
 /*
  *  Returns geocentric ecliptic coordinates.
  */
 
 RectCoords MoonBase::geo_ecl_coords() const {
-    const RectCoords hoc = helio_orb_coords();
-    const RectCoords hec = helio_ecl_coords();
+    const double days = days_since_y2000(get_jdate());
     RectCoords gec;
+    moon_block<1>(&get_orbital_elements(), m_rates, &days, &gec, 0);
+    return gec;
+}
 
-    double lon = atan2(hec.y, hec.x);
-    double lat = atan2(hec.z, hypot(hec.x, hec.y));
-    double rhc = hoc.z;
 
-    SunForMoon sfm(get_calc_time());
-    const OrbElem m_oes = get_orbital_elements();
-    const OrbElem s_oes = sfm.get_orbital_elements();
+/*
+ *  Returns geocentric ecliptic position and velocity per day, in
+ *  Earth radii for the Moon.
+ *
+ *  The velocity is calculated analytically in the same pass as the
+ *  position, by differentiating both the orbit and each of the
+ *  perturbation terms.
+ */
 
-    //  Calculate mean elongation and argument
-    //  of latitude for the moon.
+StateVector MoonBase::state() const {
+    const double days = days_since_y2000(get_jdate());
+    StateVector ges;
+    moon_block<1>(&get_orbital_elements(), m_rates, &days,
+                  &ges.position, &ges.velocity);
+    return ges;
+}
 
-    const double mel = m_oes.ml - s_oes.ml;
-    const double arl = m_oes.ml - m_oes.lan;
 
-    //  Adjust for longitude perturbations
+/*
+ *  Provide name() functions.
+ */
 
-    double dlon = -1.274 * sin(m_oes.man - 2 * mel);
-    dlon += 0.658 * sin(2 * mel);
-    dlon -= 0.186 * sin(s_oes.man);
-    dlon -= 0.059 * sin(2 * m_oes.man - 2 * mel);
-    dlon -= 0.057 * sin(m_oes.man - 2 * mel + s_oes.man);
-    dlon += 0.053 * sin(m_oes.man + 2 * mel);
-    dlon += 0.046 * sin(2 * m_oes.ml - s_oes.man);
-    dlon += 0.041 * sin(m_oes.man - s_oes.man);
-    dlon -= 0.035 * sin(m_oes.ml);
-    dlon -= 0.031 * sin(m_oes.man + s_oes.man);
-    dlon -= 0.015 * sin(2 * arl - 2 * mel);
-    dlon += 0.011 * sin(m_oes.man - 4 * mel);
-    lon = radians(dlon) + lon;
+std::string Moon::name() const {
+    return "Moon";
+}
 
-    //  Adjust for latitude perturbations
+std::string SunForMoon::name() const {
+    return " - XXXX - Sun For Moon - XXXX -";
+}
 
-    double dlat = -0.173 * sin(arl - 2 * mel);
-    dlat -= 0.055 * sin(m_oes.man - arl - 2 * mel);
-    dlat -= 0.046 * sin(m_oes.man + arl - 2 * mel);
-    dlat += 0.033 * sin(arl + 2 * mel);
-    dlat += 0.017 * sin(2 * m_oes.man + arl);
-    lat = radians(dlat) + lat;
 
-    //  Adjust for rhc perturbations
+/*
+ *  Calculates the geocentric ecliptic coordinates of the Moon, in
+ *  Earth radii, at the supplied time, and stores them in gec. If gev
+ *  is not null, the velocity, in Earth radii per day, is also
+ *  calculated and stored in it.
+ *
+ *  The results are identical to those of the Moon class, which uses
+ *  the same single-time kernel, without constructing an object.
+ */
 
-    rhc = rhc - 0.58 * cos(m_oes.man - 2 * mel);
-    rhc -= 0.46 * cos(2 * mel);
+void astro::moon_geo_ecl_coords(const JulianDate& jdate, RectCoords& gec,
+                                RectCoords * gev) {
+    const double days = MoonBase::days_since_y2000(jdate);
+    const OrbElem oes =
+        MoonBase::calc_orbital_elements(days, Moon::y2000_elements,
+                                        Moon::day_elements);
+    const OrbElem rates = MoonBase::calc_element_rates(Moon::day_elements);
+    moon_block<1>(&oes, rates, &days, &gec, gev);
+}
 
-    //  Calculate cartesian coordinates of geocentric lunar position
 
-    gec.x = rhc * cos(lon) * cos(lat);
-    gec.y = rhc * sin(lon) * cos(lat);
-    gec.z = rhc * sin(lat);
+/*
+ *  Calculates the geocentric ecliptic coordinates of the Moon, in
+ *  Earth radii, at each of the supplied Julian dates.
+ *
+ *  Arguments:
+ *    jdates - an array of Julian dates
+ *    count - the number of elements in jdates
+ *    gec - an array of at least count elements, in which the
+ *          coordinates are stored
+ *    gev - an array of at least count elements, in which the
+ *          velocities, in Earth radii per day, are stored, or null
+ *          if they are not needed
+ *
+ *  The results are identical to those of the Moon class, but the
+ *  perturbations are evaluated for blocks of times together, so
+ *  that the compiler can vectorize the sums over the times. Any
+ *  times left over after the last whole block are evaluated singly,
+ *  since a part-filled block costs as much as a full one.
+ */
 
-    return gec;
+void astro::moon_geo_ecl_coords(const double * jdates, const size_t count,
+                                RectCoords * gec, RectCoords * gev) {
+    const OrbElem rates = MoonBase::calc_element_rates(Moon::day_elements);
+    double days[moon_block_size];
+    OrbElem oes[moon_block_size];
+
+    size_t start = 0;
+    for ( ; start + moon_block_size <= count; start += moon_block_size ) {
+        for ( size_t i = 0; i < moon_block_size; ++i ) {
+            days[i] = jdates[start + i] - epoch_y2000;
+            oes[i] = MoonBase::calc_orbital_elements(days[i],
+                                                     Moon::y2000_elements,
+                                                     Moon::day_elements);
+        }
+
+        moon_block<moon_block_size>(oes, rates, days, gec + start,
+                                    gev ? gev + start : 0);
+    }
+
+    for ( ; start < count; ++start ) {
+        days[0] = jdates[start] - epoch_y2000;
+        oes[0] = MoonBase::calc_orbital_elements(days[0],
+                                                 Moon::y2000_elements,
+                                                 Moon::day_elements);
+        moon_block<1>(oes, rates, days, gec + start, gev ? gev + start : 0);
+    }
 }
 
 
+namespace {
+
 /*
- *  Provide name() functions.
+ *  Calculates geocentric ecliptic coordinates at Lanes times, given
+ *  as days since the epoch of the elements, from the supplied orbital
+ *  elements at each time and their rates of change, and stores them
+ *  in gec. If gev is not null, the velocities are also calculated and
+ *  stored in it.
  */
 
-std::string Moon::name() const {
-    return "Moon";
+template <size_t Lanes>
+void moon_block(const OrbElem * oes, const OrbElem& rates,
+                const double * days, RectCoords * gec, RectCoords * gev) {
+    const OrbElem s_rates =
+        MoonBase::calc_element_rates(SunForMoon::day_elements);
+
+    //  Calculate the unperturbed orbit, and the angles from which the
+    //  perturbations are formed, at each time.
+
+    RectCoords hec[Lanes];
+    RectCoords hev[Lanes];
+    double args[NUM_MOON_ARGS][Lanes];
+
+    for ( size_t i = 0; i < Lanes; ++i ) {
+        const OrbElem s_oes =
+            MoonBase::calc_orbital_elements(days[i],
+                                            SunForMoon::y2000_elements,
+                                            SunForMoon::day_elements);
+        orbital_state(oes[i], rates, hec[i], hev[i]);
+
+        args[ARG_MAN][i] = oes[i].man;
+        args[ARG_SUN_MAN][i] = s_oes.man;
+        args[ARG_MEL][i] = oes[i].ml - s_oes.ml;
+        args[ARG_ARL][i] = oes[i].ml - oes[i].lan;
+        args[ARG_ML][i] = oes[i].ml;
+    }
+
+    //  The rates of change of the angles are the same at every time.
+
+    double arg_rates[NUM_MOON_ARGS];
+    arg_rates[ARG_MAN] = rates.man;
+    arg_rates[ARG_SUN_MAN] = s_rates.man;
+    arg_rates[ARG_MEL] = rates.ml - s_rates.ml;
+    arg_rates[ARG_ARL] = rates.ml - rates.lan;
+    arg_rates[ARG_ML] = rates.ml;
+
+    const double * sum_rates = gev ? arg_rates : 0;
+
+    //  Calculate the perturbations
+
+    MultipleAngles<Lanes> angles;
+    calc_multiple_angles(args, angles);
+
+    double dlon[Lanes], dlon_rate[Lanes];
+    double dlat[Lanes], dlat_rate[Lanes];
+    double drhc[Lanes], drhc_rate[Lanes];
+    sum_terms(lon_terms, sizeof(lon_terms) / sizeof(lon_terms[0]),
+              angles, sum_rates, false, dlon, dlon_rate);
+    sum_terms(lat_terms, sizeof(lat_terms) / sizeof(lat_terms[0]),
+              angles, sum_rates, false, dlat, dlat_rate);
+    sum_terms(dist_terms, sizeof(dist_terms) / sizeof(dist_terms[0]),
+              angles, sum_rates, true, drhc, drhc_rate);
+
+    for ( size_t i = 0; i < Lanes; ++i ) {
+        const double rho_sq = hec[i].x * hec[i].x + hec[i].y * hec[i].y;
+        const double rho = sqrt(rho_sq);
+        const double r = sqrt(rho_sq + hec[i].z * hec[i].z);
+        const double lon = atan2(hec[i].y, hec[i].x) + radians(dlon[i]);
+        const double lat = atan2(hec[i].z, rho) + radians(dlat[i]);
+        const double rhc = r + drhc[i];
+
+        //  Calculate cartesian coordinates of geocentric lunar position
+
+        const double cos_lon = cos(lon);
+        const double sin_lon = sin(lon);
+        const double cos_lat = cos(lat);
+        const double sin_lat = sin(lat);
+
+        gec[i].x = rhc * cos_lon * cos_lat;
+        gec[i].y = rhc * sin_lon * cos_lat;
+        gec[i].z = rhc * sin_lat;
+
+        if ( !gev ) {
+            continue;
+        }
+
+        //  Differentiate the unperturbed spherical coordinates, add
+        //  the rates of the perturbations, and convert back to
+        //  cartesian.
+
+        const RectCoords& p = hec[i];
+        const RectCoords& v = hev[i];
+        const double rho_rate = (p.x * v.x + p.y * v.y) / rho;
+        const double lon_rate = (p.x * v.y - p.y * v.x) / rho_sq +
+                                radians(dlon_rate[i]);
+        const double lat_rate = (rho * v.z - p.z * rho_rate) /
+                                (rho_sq + p.z * p.z) +
+                                radians(dlat_rate[i]);
+        const double rhc_rate = (p.x * v.x + p.y * v.y + p.z * v.z) / r +
+                                drhc_rate[i];
+
+        gev[i].x = rhc_rate * cos_lon * cos_lat -
+                   rhc * (sin_lon * cos_lat * lon_rate +
+                          cos_lon * sin_lat * lat_rate);
+        gev[i].y = rhc_rate * sin_lon * cos_lat +
+                   rhc * (cos_lon * cos_lat * lon_rate -
+                          sin_lon * sin_lat * lat_rate);
+        gev[i].z = rhc_rate * sin_lat + rhc * cos_lat * lat_rate;
+    }
 }
 
-std::string SunForMoon::name() const {
-    return " - XXXX - Sun For Moon - XXXX -";
+
+/*
+ *  Calculates the cosines and sines of the multiples of each of the
+ *  supplied angles, up to max_multiple, at each of Lanes times.
+ *
+ *  Only the angles themselves need trigonometric function calls.
+ *  The higher multiples use cos((k + 1)a) = cos(ka)cos(a) -
+ *  sin(ka)sin(a) and sin((k + 1)a) = sin(ka)cos(a) + cos(ka)sin(a).
+ */
+
+template <size_t Lanes>
+void calc_multiple_angles(const double args[][Lanes],
+                          MultipleAngles<Lanes>& angles) {
+    for ( int a = 0; a < NUM_MOON_ARGS; ++a ) {
+        double * cos_1 = angles.cos_m[a][1];
+        double * sin_1 = angles.sin_m[a][1];
+
+        for ( size_t i = 0; i < Lanes; ++i ) {
+            angles.cos_m[a][0][i] = 1;
+            angles.sin_m[a][0][i] = 0;
+            cos_1[i] = cos(args[a][i]);
+            sin_1[i] = sin(args[a][i]);
+        }
+
+        for ( int k = 2; k <= max_multiple; ++k ) {
+            const double * cos_prev = angles.cos_m[a][k - 1];
+            const double * sin_prev = angles.sin_m[a][k - 1];
+            double * cos_k = angles.cos_m[a][k];
+            double * sin_k = angles.sin_m[a][k];
+
+            for ( size_t i = 0; i < Lanes; ++i ) {
+                cos_k[i] = cos_prev[i] * cos_1[i] - sin_prev[i] * sin_1[i];
+                sin_k[i] = sin_prev[i] * cos_1[i] + cos_prev[i] * sin_1[i];
+            }
+        }
+    }
 }
+
+
+/*
+ *  Sums the supplied perturbation terms at each of Lanes times,
+ *  using sines, or cosines if cosine is true, and stores the results
+ *  in sum. If arg_rates is not null, the rates of change of the sums
+ *  for the supplied rates of change of the angles are stored in rate,
+ *  otherwise rate is set to zero.
+ *
+ *  The cosine and sine of each term's argument are formed as the
+ *  real and imaginary parts of the product of the unit complex
+ *  numbers for the multiples of its angles.
+ */
+
+template <size_t Lanes>
+void sum_terms(const PerturbationTerm * terms, const size_t num_terms,
+               const MultipleAngles<Lanes>& angles,
+               const double * arg_rates, const bool cosine,
+               double * sum, double * rate) {
+    for ( size_t i = 0; i < Lanes; ++i ) {
+        sum[i] = 0;
+        rate[i] = 0;
+    }
+
+    double re[Lanes];
+    double im[Lanes];
+
+    for ( size_t t = 0; t < num_terms; ++t ) {
+        const PerturbationTerm& term = terms[t];
+
+        for ( size_t i = 0; i < Lanes; ++i ) {
+            re[i] = 1;
+            im[i] = 0;
+        }
+
+        double arg_rate = 0;
+        for ( int a = 0; a < NUM_MOON_ARGS; ++a ) {
+            const int mult = term.multipliers[a];
+            if ( mult == 0 ) {
+                continue;
+            }
+            assert(abs(mult) <= max_multiple);
+
+            if ( arg_rates ) {
+                arg_rate += mult * arg_rates[a];
+            }
+
+            const double sign = mult < 0 ? -1 : 1;
+            const double * cos_m = angles.cos_m[a][abs(mult)];
+            const double * sin_m = angles.sin_m[a][abs(mult)];
+
+            for ( size_t i = 0; i < Lanes; ++i ) {
+                const double s = sign * sin_m[i];
+                const double x = re[i] * cos_m[i] - im[i] * s;
+                im[i] = re[i] * s + im[i] * cos_m[i];
+                re[i] = x;
+            }
+        }
+
+        const double coeff = term.coeff;
+        if ( cosine ) {
+            for ( size_t i = 0; i < Lanes; ++i ) {
+                sum[i] += coeff * re[i];
+                rate[i] -= coeff * im[i] * arg_rate;
+            }
+        } else {
+            for ( size_t i = 0; i < Lanes; ++i ) {
+                sum[i] += coeff * im[i];
+                rate[i] += coeff * re[i] * arg_rate;
+            }
+        }
+    }
+}
+
+}           //  namespace
@@ -15,57 +15,74 @@
 #define PG_ASTRO_MOON_H
 
 #include <string>
+#include <cstddef>
 #include <paulgrif/utctime.h>
 #include "astro_common_types.h"
 #include "astrofunc.h"
+#include "julian_date.h"
 #include "planet.h"
 
 namespace astro {
 
 class MoonBase : public Planet {
     public:
-        explicit MoonBase(const utctime::UTCTime& ct,
+        explicit MoonBase(const JulianDate& jdate,
                           const OrbElem& y2000_oes,
                           const OrbElem& day_oes) :
-            Planet(ct, calc_orbital_elements(ct, y2000_oes, day_oes)) {}
+            Planet(jdate, calc_orbital_elements(days_since_y2000(jdate),
+                                                y2000_oes, day_oes)),
+            m_rates(calc_element_rates(day_oes)) {}
         virtual ~MoonBase() = 0;
 
         virtual RectCoords geo_ecl_coords() const;
+        virtual StateVector state() const;
+
+        static double days_since_y2000(const JulianDate& jdate);
+        static OrbElem calc_orbital_elements(const double days,
+                                             const OrbElem& y2000_oes,
+                                             const OrbElem& day_oes);
+        static OrbElem calc_element_rates(const OrbElem& day_oes);
 
     private:
-        OrbElem calc_orbital_elements(const utctime::UTCTime& calc_time,
-                                      const OrbElem& y2000_oes,
-                                      const OrbElem& day_oes) const;
+        const OrbElem m_rates;
 };
 
 class Moon : public MoonBase {
     public:
         explicit Moon(const utctime::UTCTime& ct) :
-            MoonBase(ct,
-                     OrbElem(60.2666, 0.0549,
-                             5.1454, 198.5516,
-                             83.1862, 125.1228, 0, 0),
-                     OrbElem(0, 0,
-                             0, 13.1763964649,
-                             0.111403514, -0.0529538083, 0, 0)) {}
+            Moon(julian_date_split(ct)) {}
+        explicit Moon(const JulianDate& jdate) :
+            MoonBase(jdate, y2000_elements, day_elements) {}
 
         virtual std::string name() const;
+
+        static const OrbElem y2000_elements;
+        static const OrbElem day_elements;
 };
 
 class SunForMoon : public MoonBase {
     public:
         explicit SunForMoon(const utctime::UTCTime& ct) :
-            MoonBase(ct,
-                     OrbElem(1, 0.016709,
-                             0, 278.9874,
-                             -77.0596, 0, 0, 0),
-                     OrbElem(0, -0.000000001151,
-                             0, 0.98564735200,
-                             0.00004709350, 0, 0, 0)) {}
+            SunForMoon(julian_date_split(ct)) {}
+        explicit SunForMoon(const JulianDate& jdate) :
+            MoonBase(jdate, y2000_elements, day_elements) {}
 
         virtual std::string name() const;
+
+        static const OrbElem y2000_elements;
+        static const OrbElem day_elements;
 };
 
+
+/*
+ *  Function prototypes
+ */
+
+void moon_geo_ecl_coords(const JulianDate& jdate, RectCoords& gec,
+                         RectCoords * gev);
+void moon_geo_ecl_coords(const double * jdates, const size_t count,
+                         RectCoords * gec, RectCoords * gev);
+
 }           //  namespace astro
 
 #endif          // PG_ASTRO_MOON_H
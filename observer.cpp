@@ -0,0 +1,225 @@
+/*
+ *  observer.cpp
+ *  ============
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of Observer type and topocentric position
+ *  calculations.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <cstddef>
+#include <cmath>
+#include <cassert>
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "julian_date.h"
+#include "body_state.h"
+#include "sidereal.h"
+#include "observer.h"
+
+using std::sin;
+using std::cos;
+using std::atan2;
+using std::sqrt;
+
+using namespace astro;
+
+
+/*
+ *  Local constants
+ */
+
+namespace {
+
+//  Equatorial radius of the Earth, in metres
+
+const double earth_radius_m = 6378140;
+
+}           //  namespace
+
+
+/*
+ *  Local function prototypes
+ */
+
+namespace {
+
+void topo_coords(const Observer& obs, const double cos_gmst,
+                 const double sin_gmst, const RectCoords& gqc,
+                 const double earth_radius, TopoCoords& topo);
+
+}           //  namespace
+
+
+/*
+ *  Default constructor, for an observer at sea level at latitude and
+ *  longitude zero.
+ */
+
+Observer::Observer() :
+    Observer(0, 0, 0) {}
+
+
+/*
+ *  Constructor.
+ *
+ *  Arguments:
+ *    lat - the geodetic latitude, in degrees, north positive
+ *    lon - the longitude, in degrees, east positive
+ *    elev - the elevation, in metres above sea level
+ *
+ *  The observer's position relative to the centre of the Earth
+ *  allows for the flattening of the Earth.
+ */
+
+Observer::Observer(const double lat, const double lon, const double elev) :
+    latitude(lat),
+    longitude(lon),
+    elevation(elev),
+    sin_lat(sin(radians(lat))),
+    cos_lat(cos(radians(lat))),
+    sin_lon(sin(radians(lon))),
+    cos_lon(cos(radians(lon))),
+    rho_sin_phi(0),
+    rho_cos_phi(0) {
+    assert(lat >= -90 && lat <= 90);
+
+    const double u = atan2((1 - EARTH_FLATTENING) * sin_lat, cos_lat);
+    const double h = elev / earth_radius_m;
+    rho_sin_phi = (1 - EARTH_FLATTENING) * sin(u) + h * sin_lat;
+    rho_cos_phi = cos(u) + h * cos_lat;
+}
+
+
+/*
+ *  Calculates the position of a body as seen by the supplied observer
+ *  at the supplied time, and stores it in (and modifies) the supplied
+ *  TopoCoords struct.
+ *
+ *  Arguments:
+ *    obs - the observer
+ *    jdate - the time of the observation
+ *    gqc - the geocentric equatorial coordinates of the body
+ *    earth_radius - the Earth's equatorial radius in the same units
+ *                   as gqc, i.e. EARTH_RADIUS_AU for coordinates in
+ *                   AU, or 1 for coordinates in Earth radii. Zero
+ *                   ignores parallax, and gives the geocentric
+ *                   position referred to the observer's horizon.
+ *    topo - the struct in which to store the result
+ *
+ *  Positions are referred to the J2000 equator, as are all positions
+ *  in this library, and the hour angle and altitude ignore precession
+ *  since J2000, nutation and refraction.
+ */
+
+void astro::topocentric(const Observer& obs, const JulianDate& jdate,
+                        const RectCoords& gqc, const double earth_radius,
+                        TopoCoords& topo) {
+    const double theta = radians(gmst(jdate));
+    topo_coords(obs, cos(theta), sin(theta), gqc, earth_radius, topo);
+}
+
+
+/*
+ *  Calculates the position of the supplied body as seen by the
+ *  supplied observer at the supplied time, as above. Parallax is
+ *  applied, which for the Moon is up to about a degree.
+ */
+
+void astro::topocentric(const Observer& obs, const BodyId body,
+                        const JulianDate& jdate, TopoCoords& topo) {
+    topocentric(&obs, 1, body, jdate, &topo);
+}
+
+
+/*
+ *  Calculates the position of the supplied body at the supplied time
+ *  as seen by each of count observers, and stores them in the
+ *  supplied array of at least count elements.
+ *
+ *  The geocentric position of the body and the sidereal time are
+ *  calculated only once, and shared between all the observers, so
+ *  that each observer costs only a few arithmetic operations and
+ *  inverse trigonometric functions.
+ */
+
+void astro::topocentric(const Observer * observers, const size_t count,
+                        const BodyId body, const JulianDate& jdate,
+                        TopoCoords * topo) {
+    RectCoords gqc;
+    geo_equ_coords(body, jdate, gqc);
+
+    const double earth_radius = body_earth_radius(body);
+    const double theta = radians(gmst(jdate));
+    const double cos_gmst = cos(theta);
+    const double sin_gmst = sin(theta);
+
+    for ( size_t i = 0; i < count; ++i ) {
+        topo_coords(observers[i], cos_gmst, sin_gmst, gqc,
+                    earth_radius, topo[i]);
+    }
+}
+
+
+/*
+ *  Returns the Earth's equatorial radius in the units of distance
+ *  used for the supplied body, for passing to topocentric().
+ */
+
+double astro::body_earth_radius(const BodyId body) {
+    return body == BODY_MOON ? 1 : EARTH_RADIUS_AU;
+}
+
+
+namespace {
+
+/*
+ *  Calculates topocentric coordinates from geocentric equatorial
+ *  coordinates, given the cosine and sine of the Greenwich mean
+ *  sidereal time.
+ */
+
+void topo_coords(const Observer& obs, const double cos_gmst,
+                 const double sin_gmst, const RectCoords& gqc,
+                 const double earth_radius, TopoCoords& topo) {
+
+    //  Local sidereal time from the Greenwich sidereal time and the
+    //  observer's longitude, by the angle addition formulae
+
+    const double cos_lst = cos_gmst * obs.cos_lon - sin_gmst * obs.sin_lon;
+    const double sin_lst = sin_gmst * obs.cos_lon + cos_gmst * obs.sin_lon;
+
+    //  Subtract the observer's geocentric position to apply parallax
+
+    RectCoords tqc;
+    tqc.x = gqc.x - earth_radius * obs.rho_cos_phi * cos_lst;
+    tqc.y = gqc.y - earth_radius * obs.rho_cos_phi * sin_lst;
+    tqc.z = gqc.z - earth_radius * obs.rho_sin_phi;
+
+    SphCoords sph;
+    rec_to_sph(tqc, sph);
+    topo.right_ascension = normalize_degrees(sph.right_ascension);
+    topo.declination = sph.declination;
+    topo.distance = sph.distance;
+
+    //  Rotate to the meridian, where a and b are the components of
+    //  the position along and perpendicular to it in the equatorial
+    //  plane, and then to the horizon.
+
+    const double a = tqc.x * cos_lst + tqc.y * sin_lst;
+    const double b = tqc.x * sin_lst - tqc.y * cos_lst;
+    const double east = -b;
+    const double north = tqc.z * obs.cos_lat - a * obs.sin_lat;
+    const double up = tqc.z * obs.sin_lat + a * obs.cos_lat;
+
+    topo.hour_angle = degrees(atan2(b, a));
+    topo.altitude = degrees(atan2(up, sqrt(east * east + north * north)));
+    topo.azimuth = normalize_degrees(degrees(atan2(east, north)));
+}
+
+}           //  namespace
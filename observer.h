@@ -0,0 +1,90 @@
+/*
+ *  observer.h
+ *  ==========
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to Observer type and topocentric position calculations.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_OBSERVER_H
+#define PG_ASTRO_OBSERVER_H
+
+#include <cstddef>
+#include "astro_common_types.h"
+#include "julian_date.h"
+
+namespace astro {
+
+/*
+ *  Constants
+ */
+
+//  Equatorial radius of the Earth, in AU, and its flattening
+
+constexpr double EARTH_RADIUS_AU = 6378.14 / 149597870.7;
+constexpr double EARTH_FLATTENING = 1 / 298.257;
+
+
+/*
+ *  A location on the Earth's surface. The trigonometric functions of
+ *  the latitude and longitude, and the observer's position relative
+ *  to the centre of the Earth, are calculated once on construction,
+ *  and reused for every position calculated for the observer.
+ */
+
+struct Observer {
+    double latitude;        // Geodetic, in degrees, north positive
+    double longitude;       // Degrees, east positive
+    double elevation;       // Metres above sea level
+    double sin_lat;
+    double cos_lat;
+    double sin_lon;
+    double cos_lon;
+    double rho_sin_phi;     // Distance from the equatorial plane, and
+    double rho_cos_phi;     // from the Earth's axis, in Earth radii
+
+    Observer();
+    Observer(const double lat, const double lon, const double elev = 0);
+};
+
+
+/*
+ *  The position of a body as seen by an observer.
+ */
+
+struct TopoCoords {
+    double right_ascension;     // Degrees, 0 <= ra < 360
+    double declination;         // Degrees
+    double distance;            // AU, or Earth radii for the Moon
+    double hour_angle;          // Degrees west, -180 < ha <= 180
+    double altitude;            // Degrees above the horizon
+    double azimuth;             // Degrees east of north, 0 <= az < 360
+
+    TopoCoords() :
+        right_ascension(0), declination(0), distance(0),
+        hour_angle(0), altitude(0), azimuth(0) {}
+};
+
+
+/*
+ *  Function prototypes
+ */
+
+void topocentric(const Observer& obs, const JulianDate& jdate,
+                 const RectCoords& gqc, const double earth_radius,
+                 TopoCoords& topo);
+void topocentric(const Observer& obs, const BodyId body,
+                 const JulianDate& jdate, TopoCoords& topo);
+void topocentric(const Observer * observers, const size_t count,
+                 const BodyId body, const JulianDate& jdate,
+                 TopoCoords * topo);
+double body_earth_radius(const BodyId body);
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_OBSERVER_H
@@ -0,0 +1,100 @@
+/*
+ *  orbit_rotation.cpp
+ *  ==================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of OrbitRotation class.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <cstddef>
+#include <cmath>
+#include <cassert>
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "orbit_rotation.h"
+
+using std::fabs;
+
+using namespace astro;
+
+
+/*
+ *  Constructor.
+ *
+ *  The matrix is reused while the argument of perihelion, longitude
+ *  of the ascending node and inclination each remain within the
+ *  supplied tolerance, in radians, of the values it was calculated
+ *  from. The error in a rotated position is at most about the
+ *  tolerance times the distance. A tolerance of zero recalculates
+ *  the matrix whenever any of the angles changes, and gives results
+ *  identical to orb_to_ecl() with the orbital elements.
+ */
+
+OrbitRotation::OrbitRotation(const double tolerance) :
+    m_tolerance(tolerance),
+    m_valid(false),
+    m_arp(0),
+    m_lan(0),
+    m_inc(0),
+    m_matrix(),
+    m_recalculations(0) {
+    assert(tolerance >= 0);
+}
+
+
+/*
+ *  Recalculates the matrix for the supplied orbital elements, unless
+ *  the current one is within tolerance of them.
+ */
+
+void OrbitRotation::update(const OrbElem& oes) {
+    if ( m_valid &&
+         fabs(oes.arp - m_arp) <= m_tolerance &&
+         fabs(oes.lan - m_lan) <= m_tolerance &&
+         fabs(oes.inc - m_inc) <= m_tolerance ) {
+        return;
+    }
+
+    orb_to_ecl_matrix(oes, m_matrix);
+    m_arp = oes.arp;
+    m_lan = oes.lan;
+    m_inc = oes.inc;
+    m_valid = true;
+    ++m_recalculations;
+}
+
+
+/*
+ *  Converts heliocentric coordinates in the orbital plane to
+ *  heliocentric coordinates in the J2000 ecliptic plane, using the
+ *  current matrix.
+ */
+
+void OrbitRotation::orb_to_ecl(const RectCoords& hoc,
+                               RectCoords& hec) const {
+    assert(m_valid);
+    astro::orb_to_ecl(m_matrix, hoc, hec);
+}
+
+
+/*
+ *  Returns the current matrix.
+ */
+
+const RotMatrix& OrbitRotation::matrix() const {
+    return m_matrix;
+}
+
+
+/*
+ *  Returns the number of times the matrix has been calculated.
+ */
+
+size_t OrbitRotation::recalculations() const {
+    return m_recalculations;
+}
@@ -0,0 +1,44 @@
+/*
+ *  orbit_rotation.h
+ *  ================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to OrbitRotation class, for reusing an orbital plane
+ *  to ecliptic rotation matrix over a number of calculations.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_ORBIT_ROTATION_H
+#define PG_ASTRO_ORBIT_ROTATION_H
+
+#include <cstddef>
+#include "astro_common_types.h"
+
+namespace astro {
+
+class OrbitRotation {
+    public:
+        explicit OrbitRotation(const double tolerance = 0);
+
+        void update(const OrbElem& oes);
+        void orb_to_ecl(const RectCoords& hoc, RectCoords& hec) const;
+        const RotMatrix& matrix() const;
+        size_t recalculations() const;
+
+    private:
+        double m_tolerance;
+        bool m_valid;
+        double m_arp;
+        double m_lan;
+        double m_inc;
+        RotMatrix m_matrix;
+        size_t m_recalculations;
+};
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_ORBIT_ROTATION_H
@@ -13,17 +13,13 @@
 
 #include <string>
 #include <cmath>
+#include <ctime>
 #include <paulgrif/utctime.h>
 #include "astro_common_types.h"
 #include "astrofunc.h"
 #include "major_body.h"
 #include "planets.h"
 
-using std::cos;
-using std::sin;
-using std::sqrt;
-using std::pow;
-
 using namespace astro;
 
 
@@ -35,20 +31,36 @@ Planet::~Planet() {}
 
 
 /*
- *  Returns a UTCTime class containing the calculation time
+ *  Returns the Julian date of the calculation time.
+ */
+
+const JulianDate& Planet::get_jdate() const {
+    return m_jdate;
+}
+
+
+/*
+ *  Returns the calculation time of the planet, to the nearest second.
  */
 
-const utctime::UTCTime& Planet::get_calc_time() const {
-    return m_calc_time;
+utctime::UTCTime Planet::get_calc_time() const {
+    const std::time_t secs = static_cast<std::time_t>(unix_seconds(m_jdate));
+    std::tm utc;
+    gmtime_r(&secs, &utc);
+
+    return utctime::UTCTime(utc.tm_year + 1900, utc.tm_mon + 1,
+                            utc.tm_mday, utc.tm_hour, utc.tm_min,
+                            utc.tm_sec);
 }
 
 
 /*
- *  Returns a string representation of the calculation time of the planet.
+ *  Returns a string representation of the calculation time of the
+ *  planet, to the nearest second.
  */
 
 std::string Planet::calc_time_string() const {
-    return m_calc_time.time_string();
+    return get_calc_time().time_string();
 }
 
 
@@ -67,12 +79,7 @@ const OrbElem& Planet::get_orbital_elements() const {
 
 RectCoords Planet::helio_orb_coords() const {
     RectCoords hoc;
-
-    const double e_anom = kepler(m_oes.man, m_oes.ecc);
-
-    hoc.x = m_oes.sma * (cos(e_anom) - m_oes.ecc);
-    hoc.y = m_oes.sma * sqrt(1 - pow(m_oes.ecc, 2)) * sin(e_anom);
-    hoc.z = hypot(hoc.x, hoc.y);
+    orbital_coords(m_oes, hoc);
 
     return hoc;
 }
@@ -85,18 +92,8 @@ RectCoords Planet::helio_orb_coords() const {
 RectCoords Planet::helio_ecl_coords() const {
     const RectCoords hoc = helio_orb_coords();
     RectCoords hec;
+    orb_to_ecl(m_oes, hoc, hec);
 
-    hec.x = (((cos(m_oes.arp) * cos(m_oes.lan) -
-               sin(m_oes.arp) * sin(m_oes.lan) * cos(m_oes.inc)) * hoc.x) +
-             ((-sin(m_oes.arp) * cos(m_oes.lan) -
-                cos(m_oes.arp) * sin(m_oes.lan) * cos(m_oes.inc)) * hoc.y));
-    hec.y = (((cos(m_oes.arp) * sin(m_oes.lan) +
-               sin(m_oes.arp) * cos(m_oes.lan) * cos(m_oes.inc)) * hoc.x) +
-             ((-sin(m_oes.arp) * sin(m_oes.lan) +
-                cos(m_oes.arp) * cos(m_oes.lan) * cos(m_oes.inc)) * hoc.y));
-    hec.z = ((sin(m_oes.arp) * sin(m_oes.inc) * hoc.x) +
-             (cos(m_oes.arp) * sin(m_oes.inc) * hoc.y));
-            
     return hec;
 }
 
@@ -106,52 +103,54 @@ RectCoords Planet::helio_ecl_coords() const {
  */
 
 RectCoords Planet::geo_equ_coords() const {
-    static const double obliquity = radians(23.43928);
     const RectCoords gec = geo_ecl_coords();
     RectCoords gqc;
-
-    gqc.x = gec.x;
-    gqc.y = gec.y * cos(obliquity) - gec.z * sin(obliquity);
-    gqc.z = gec.y * sin(obliquity) + gec.z * cos(obliquity);
+    ecl_to_equ(gec, gqc);
 
     return gqc;
 }
 
 
 /*
- *  Calculates the planet's right ascension.
+ *  Returns the planet's geocentric spherical coordinates.
+ *
+ *  The coordinates are calculated on the first call, and the
+ *  cached result is returned on subsequent calls.
  */
 
-double Planet::right_ascension() const {
-    const RectCoords gqc = geo_equ_coords();
-    SphCoords sph;
-    rec_to_sph(gqc, sph);
+const SphCoords& Planet::spherical() const {
+    if ( !m_sph_valid ) {
+        ecl_to_sph(geo_ecl_coords(), m_sph);
+        m_sph_valid = true;
+    }
 
-    return sph.right_ascension;
+    return m_sph;
 }
 
 
 /*
- *  Calculates the planet's declination
+ *  Returns the planet's right ascension.
  */
 
-double Planet::declination() const {
-    const RectCoords gqc = geo_equ_coords();
-    SphCoords sph;
-    rec_to_sph(gqc, sph);
+double Planet::right_ascension() const {
+    return spherical().right_ascension;
+}
+
 
-    return sph.declination;
+/*
+ *  Returns the planet's declination
+ */
+
+double Planet::declination() const {
+    return spherical().declination;
 }
 
 
 /*
- *  Calculates the planet's distance
+ *  Returns the planet's distance
  */
 
 double Planet::distance() const {
-    const RectCoords gqc = geo_equ_coords();
-    SphCoords sph;
-    rec_to_sph(gqc, sph);
-
-    return sph.distance;
+    return spherical().distance;
 }
+
@@ -18,18 +18,22 @@
 #include <paulgrif/utctime.h>
 #include "astro_common_types.h"
 #include "astrofunc.h"
+#include "julian_date.h"
 
 namespace astro {
 
 class Planet {
     public:
-        explicit Planet(const utctime::UTCTime& calc_time, const OrbElem& oes) :
-            m_calc_time(calc_time),
-            m_oes(oes) {}
+        explicit Planet(const JulianDate& jdate, const OrbElem& oes) :
+            m_jdate(jdate),
+            m_oes(oes),
+            m_sph_valid(false),
+            m_sph() {}
         virtual ~Planet() = 0;
 
         virtual std::string name() const = 0;
-        const utctime::UTCTime& get_calc_time() const;
+        const JulianDate& get_jdate() const;
+        utctime::UTCTime get_calc_time() const;
         std::string calc_time_string() const;
 
         const OrbElem& get_orbital_elements() const;
@@ -37,13 +41,24 @@ class Planet {
         virtual RectCoords helio_ecl_coords() const;
         virtual RectCoords geo_ecl_coords() const = 0;
         virtual RectCoords geo_equ_coords() const;
+        virtual StateVector state() const = 0;
+        const SphCoords& spherical() const;
         double right_ascension() const;
         double declination() const;
         double distance() const;
 
     private:
-        const utctime::UTCTime m_calc_time;
+        const JulianDate m_jdate;
         const OrbElem m_oes;
+
+        //  Spherical coordinates are calculated on first use, and
+        //  cached. Planet objects are therefore not safe to share
+        //  between threads without external synchronization, although
+        //  separate Planet objects may be used freely in separate
+        //  threads.
+
+        mutable bool m_sph_valid;
+        mutable SphCoords m_sph;
 };
 
 }           //  namespace astro
@@ -12,51 +12,47 @@
 
 
 #include <iostream>
-#include <iomanip>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <cassert>
 #include <paulgrif/utctime.h>
-#include "astrofunc.h" 
-#include "planets.h"
-#include "moon.h"
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "solar_system.h"
 #include "planet_func.h"
 
 using namespace astro;
 
 
+/*
+ *  Local function prototypes
+ */
+
+namespace {
+
+char * write_fixed(char * buffer, const double value, const int width);
+
+}           //  namespace
+
+
 /*
  *  Standalone function to output all the planetary positions.
  */
 
 void astro::show_planet_positions(std::ostream& out) {
 
-    //  Set up planets
+    //  Calculate positions for all the planets at once
 
     const utctime::UTCTime utc;
 
-    const Sun sun(utc);
-    const Mercury mercury(utc);
-    const Venus venus(utc);
-    const Mars mars(utc);
-    const Jupiter jupiter(utc);
-    const Saturn saturn(utc);
-    const Uranus uranus(utc);
-    const Neptune neptune(utc);
-    const Pluto pluto(utc);
-    const Moon moon(utc);
-
-    const Planet* planets[] = {&sun, &mercury, &venus,
-                               &mars, &jupiter, &saturn,
-                               &uranus, &neptune, &pluto, &moon};
-
-    //  Set up ios flags, and set precision
-
-    const std::ios_base::fmtflags original_flags = out.flags();
-    const std::streamsize origprec = out.precision(7);
-    out.setf(out.fixed);
-    
+    SolarSystemSnapshot snap;
+    solar_system_snapshot(utc, snap);
+
     //  Output planetary positions
 
     out << "Current planetary data for "
-        << sun.calc_time_string()
+        << utc.time_string()
         << std::endl << std::endl;
 
     out << "PLANET    R.ASCENSION   DECLINATION  DIST (AU)*"
@@ -66,27 +62,143 @@ void astro::show_planet_positions(std::ostream& out) {
         << " ====== ==========="
         << std::endl;
 
-    for ( int i = 0; i < 10; ++i ) {
-        out.unsetf(std::ios::right);
-        out.setf(std::ios::left, std::ios::adjustfield);
-        out << std::setw(8) << planets[i]->name();
-        out.unsetf(std::ios::left);
-        out.setf(std::ios::right, std::ios::adjustfield);
-        out << ": "
-            << rasc_string(planets[i]->right_ascension()) << ", "
-            << decl_string(planets[i]->declination()) << ", "
-            << std::setw(10) << planets[i]->distance() << " "
-            << rasc_to_zodiac(planets[i]->right_ascension()) << " "
-            << zodiac_sign(planets[i]->right_ascension())
-            << std::endl;
+    char row[POSITION_ROW_SIZE];
+    for ( int i = 0; i < NUM_BODIES; ++i ) {
+        const size_t length = format_position_row(static_cast<BodyId>(i),
+                                                  snap.bodies[i], row);
+        out.write(row, length);
+    }
+
+    out << std::endl
+        << "* Distance for the moon given in Earth radii."
+        << std::endl;
+}
+
+
+/*
+ *  Writes a row of the table output by show_planet_positions(),
+ *  including the trailing newline, for the supplied body and
+ *  position to the supplied buffer, which must be at least
+ *  POSITION_ROW_SIZE characters long.
+ *
+ *  The output is null terminated, and its length, excluding the
+ *  terminating null character, is returned. No memory is allocated,
+ *  so this is suitable for writing very large numbers of rows.
+ */
+
+size_t astro::format_position_row(const BodyId body, const BodyPosition& pos,
+                                  char * buffer) {
+    static const size_t name_width = 8;
+    static const int dist_width = 10;
+
+    const char * name = body_name(body);
+    const size_t name_length = std::strlen(name);
+
+    char * p = buffer;
+    std::memcpy(p, name, name_length);
+    p += name_length;
+    for ( size_t i = name_length; i < name_width; ++i ) {
+        *p++ = ' ';
     }
+    *p++ = ':';
+    *p++ = ' ';
+    p += rasc_string(pos.right_ascension, p);
+    *p++ = ',';
+    *p++ = ' ';
+    p += decl_string(pos.declination, p);
+    *p++ = ',';
+    *p++ = ' ';
+    p = write_fixed(p, pos.distance, dist_width);
+    *p++ = ' ';
+    p += rasc_to_zodiac(pos.right_ascension, p);
+    *p++ = ' ';
+
+    const char * sign = zodiac_sign(pos.right_ascension);
+    const size_t sign_length = std::strlen(sign);
+    std::memcpy(p, sign, sign_length);
+    p += sign_length;
+    *p++ = '\n';
+    *p = '\0';
+
+    assert(static_cast<size_t>(p - buffer) < POSITION_ROW_SIZE);
+
+    return p - buffer;
+}
+
 
-    std::cout << std::endl
-              << "* Distance for the moon given in Earth radii."
-              << std::endl;
+namespace {
+
+/*
+ *  Writes the supplied value in fixed point notation with seven
+ *  decimal places, right justified with spaces to at least the
+ *  specified width, to the supplied buffer. Returns a pointer to
+ *  the character following the last one written. The output is
+ *  not null terminated.
+ *
+ *  The output is the same as that of std::ostream and printf(),
+ *  which round the exact binary value to nearest, ties to even. The
+ *  value is therefore scaled exactly, as the unevaluated sum of two
+ *  doubles, rather than rounded once by the multiplication and again
+ *  when converted to an integer.
+ */
 
-    //  Set ios flags and precision back to original values
+char * write_fixed(char * buffer, const double value, const int width) {
+    static const int precision = 7;
+    static const double scale = 1e7;
+    static const double splitter = 134217729.0;     //  2^27 + 1
+
+    assert(std::fabs(value) < 1e8);
+
+    //  Split the value into halves of at most 26 and 27 bits. The
+    //  scale has 24 bits, so each half multiplies by it exactly, and
+    //  their sum is rounded to product, with the error in error.
+
+    const double absval = std::fabs(value);
+    const double split = splitter * absval;
+    const double high = split - (split - absval);
+    const double low = absval - high;
+    const double high_product = high * scale;
+    const double low_product = low * scale;
+    const double product = high_product + low_product;
+    const double low_part = product - high_product;
+    const double error = (high_product - (product - low_part)) +
+                         (low_product - low_part);
+
+    //  The exact fractional part is (product - whole) + error,
+    //  which lies in (-1, 1), and (product - whole) - 0.5 is exact.
+
+    const double whole = std::floor(product);
+    const double half_diff = (product - whole) - 0.5;
+    unsigned long long scaled = static_cast<unsigned long long>(whole);
+    if ( half_diff > -error ||
+         (half_diff == -error && scaled % 2 != 0) ) {
+        ++scaled;
+    }
+    const bool negative = std::signbit(value);
+
+    char digits[24];
+    int num_digits = 0;
+    do {
+        digits[num_digits++] = '0' + scaled % 10;
+        scaled /= 10;
+    } while ( scaled != 0 || num_digits <= precision );
+
+    const int length = num_digits + 1 + (negative ? 1 : 0);
+    for ( int i = length; i < width; ++i ) {
+        *buffer++ = ' ';
+    }
+    if ( negative ) {
+        *buffer++ = '-';
+    }
+    while ( num_digits > precision ) {
+        *buffer++ = digits[--num_digits];
+    }
+    *buffer++ = '.';
+    while ( num_digits > 0 ) {
+        *buffer++ = digits[--num_digits];
+    }
 
-    out.precision(origprec);
-    out.flags(original_flags);
+    return buffer;
 }
+
+}           //  namespace
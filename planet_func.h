@@ -15,10 +15,20 @@
 #define PG_ASTRO_PLANET_FUNC_H
 
 #include <iostream>
+#include <cstddef>
+#include "astro_common_types.h"
+#include "solar_system.h"
 
 namespace astro {
 
+//  Minimum size of the buffer passed to format_position_row(),
+//  including the terminating null character
+
+constexpr size_t POSITION_ROW_SIZE = 96;
+
 void show_planet_positions(std::ostream& out);
+size_t format_position_row(const BodyId body, const BodyPosition& pos,
+                           char * buffer);
 
 }           //  namespace astro
 
@@ -16,6 +16,7 @@
 
 using namespace astro;
 
+
 /*
  *  Override helio_XXX_coords() member functions for Sun.
  *
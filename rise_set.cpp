@@ -0,0 +1,353 @@
+/*
+ *  rise_set.cpp
+ *  ============
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of rise, transit and set time calculations.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <cmath>
+#include <cassert>
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "julian_date.h"
+#include "body_state.h"
+#include "observer.h"
+#include "rise_set.h"
+
+using std::asin;
+using std::fabs;
+
+using namespace astro;
+
+
+/*
+ *  Local constants
+ */
+
+namespace {
+
+//  Number of steps into which the day is divided when sampling the
+//  altitude. Each step is two hours, short enough that a body cannot
+//  both rise and set within one, except when it barely grazes the
+//  horizon.
+
+const int samples_per_day = 12;
+
+//  Tolerance, in days, to which event times are refined, and
+//  maximum number of root finding iterations
+
+const double event_tolerance = 1e-5;
+const int max_refine_iterations = 100;
+
+//  Radius of the Moon, in Earth radii
+
+const double moon_radius = 0.2725;
+
+}           //  namespace
+
+
+/*
+ *  Local types
+ */
+
+namespace {
+
+//  The observer, day and target altitude of a search
+
+struct SearchContext {
+    Observer obs;
+    JulianDate day_start;
+    double earth_radius;
+    double altitude;
+    bool lunar_limb;        // True to allow for the Moon's semi-diameter
+};
+
+//  One sampling step, from t0 to t1 days after the start of the day,
+//  with the geocentric equatorial coordinates of the body at each end
+
+struct Bracket {
+    double t0;
+    double t1;
+    RectCoords gqc0;
+    RectCoords gqc1;
+};
+
+typedef double (*BracketFunc)(const SearchContext& ctx, const Bracket& br,
+                              const double t);
+
+}           //  namespace
+
+
+/*
+ *  Local function prototypes
+ */
+
+namespace {
+
+void solve(const BodyId body, const Observer& obs,
+           const JulianDate& day_start, const double altitude,
+           const bool lunar_limb, RiseTransitSet& rts);
+double altitude_offset(const SearchContext& ctx, const TopoCoords& topo);
+void topo_at(const SearchContext& ctx, const Bracket& br, const double t,
+             TopoCoords& topo);
+double altitude_at(const SearchContext& ctx, const Bracket& br,
+                   const double t);
+double hour_angle_at(const SearchContext& ctx, const Bracket& br,
+                     const double t);
+double find_root(const SearchContext& ctx, const Bracket& br,
+                 const BracketFunc func, double f0, double f1);
+
+}           //  namespace
+
+
+/*
+ *  Calculates the times at which the supplied body rises, transits
+ *  and sets, as seen by the supplied observer, during the day of
+ *  UT starting at day_start, and stores them in (and modifies) the
+ *  supplied RiseTransitSet struct.
+ *
+ *  A body rises and sets when the upper limb of the Sun or the Moon,
+ *  or the centre of a planet, is at the horizon, allowing for
+ *  refraction. If a body rises or sets more than once in the day, the
+ *  first is reported.
+ *
+ *  The altitude is sampled every two hours, and each crossing found
+ *  is refined by root finding to within about a second. Within each
+ *  sampling step, the body's geocentric position is interpolated
+ *  between the two samples, so that each root finding iteration
+ *  recalculates only the observer's sidereal rotation, rather than
+ *  the position of the body. The interpolation changes times by no
+ *  more than a few seconds, which is well within the precision of the
+ *  positions themselves, since they are referred to the J2000
+ *  equator.
+ */
+
+void astro::rise_transit_set(const BodyId body, const Observer& obs,
+                             const JulianDate& day_start,
+                             RiseTransitSet& rts) {
+    if ( body == BODY_SUN ) {
+        solve(body, obs, day_start, SUN_RISE_SET_ALTITUDE, false, rts);
+    } else {
+        solve(body, obs, day_start, RISE_SET_ALTITUDE,
+              body == BODY_MOON, rts);
+    }
+}
+
+
+/*
+ *  Calculates the times at which the centre of the supplied body
+ *  crosses the supplied altitude, in degrees, and the meridian, as
+ *  above.
+ */
+
+void astro::rise_transit_set(const BodyId body, const Observer& obs,
+                             const JulianDate& day_start,
+                             const double altitude, RiseTransitSet& rts) {
+    solve(body, obs, day_start, altitude, false, rts);
+}
+
+
+/*
+ *  Calculates the times of dawn and dusk for the supplied kind of
+ *  twilight, and of the Sun's transit, as above. Dawn and dusk are
+ *  stored as the rise and set times.
+ */
+
+void astro::sun_twilight(const Observer& obs, const JulianDate& day_start,
+                         const Twilight twilight, RiseTransitSet& rts) {
+    static const double altitudes[] = {
+        CIVIL_TWILIGHT_ALTITUDE, NAUTICAL_TWILIGHT_ALTITUDE,
+        ASTRONOMICAL_TWILIGHT_ALTITUDE
+    };
+
+    assert(twilight >= TWILIGHT_CIVIL && twilight <= TWILIGHT_ASTRONOMICAL);
+
+    solve(BODY_SUN, obs, day_start, altitudes[twilight], false, rts);
+}
+
+
+namespace {
+
+/*
+ *  Samples the altitude and hour angle of the body over the day, and
+ *  refines the first rising, setting and transit found.
+ */
+
+void solve(const BodyId body, const Observer& obs,
+           const JulianDate& day_start, const double altitude,
+           const bool lunar_limb, RiseTransitSet& rts) {
+    const SearchContext ctx = {obs, day_start, body_earth_radius(body),
+                               altitude, lunar_limb};
+
+    RectCoords gqc[samples_per_day + 1];
+    double alts[samples_per_day + 1];
+    double has[samples_per_day + 1];
+
+    for ( int i = 0; i <= samples_per_day; ++i ) {
+        const double t = static_cast<double>(i) / samples_per_day;
+        const JulianDate jdate(day_start.day, day_start.fraction + t);
+        geo_equ_coords(body, jdate, gqc[i]);
+
+        TopoCoords topo;
+        topocentric(obs, jdate, gqc[i], ctx.earth_radius, topo);
+        alts[i] = altitude_offset(ctx, topo);
+        has[i] = topo.hour_angle;
+    }
+
+    rts = RiseTransitSet();
+    rts.body = body;
+
+    for ( int i = 0; i < samples_per_day; ++i ) {
+        const Bracket br = {static_cast<double>(i) / samples_per_day,
+                            static_cast<double>(i + 1) / samples_per_day,
+                            gqc[i], gqc[i + 1]};
+
+        if ( !rts.has_rise && alts[i] < 0 && alts[i + 1] >= 0 ) {
+            rts.rise = day_start.value() +
+                       find_root(ctx, br, altitude_at,
+                                 alts[i], alts[i + 1]);
+            rts.has_rise = true;
+        }
+
+        if ( !rts.has_set && alts[i] >= 0 && alts[i + 1] < 0 ) {
+            rts.set = day_start.value() +
+                      find_root(ctx, br, altitude_at,
+                                alts[i], alts[i + 1]);
+            rts.has_set = true;
+        }
+
+        //  The hour angle passes through zero at transit, and jumps
+        //  from +180 to -180 at the lower transit, which is ignored.
+
+        if ( !rts.has_transit && has[i] < 0 && has[i + 1] >= 0 &&
+             has[i + 1] - has[i] < 180 ) {
+            rts.transit = day_start.value() +
+                          find_root(ctx, br, hour_angle_at,
+                                    has[i], has[i + 1]);
+            rts.has_transit = true;
+        }
+    }
+
+    if ( !rts.has_rise && !rts.has_set ) {
+        rts.always_above = alts[0] >= 0;
+        rts.always_below = alts[0] < 0;
+    }
+}
+
+
+/*
+ *  Returns the amount, in degrees, by which the body is above the
+ *  target altitude.
+ */
+
+double altitude_offset(const SearchContext& ctx, const TopoCoords& topo) {
+    double target = ctx.altitude;
+    if ( ctx.lunar_limb ) {
+        target -= degrees(asin(moon_radius / topo.distance));
+    }
+
+    return topo.altitude - target;
+}
+
+
+/*
+ *  Calculates the topocentric coordinates of the body at t days after
+ *  the start of the day, interpolating its geocentric coordinates
+ *  between the ends of the supplied step.
+ */
+
+void topo_at(const SearchContext& ctx, const Bracket& br, const double t,
+             TopoCoords& topo) {
+    const double w = (t - br.t0) / (br.t1 - br.t0);
+
+    RectCoords gqc;
+    gqc.x = br.gqc0.x + w * (br.gqc1.x - br.gqc0.x);
+    gqc.y = br.gqc0.y + w * (br.gqc1.y - br.gqc0.y);
+    gqc.z = br.gqc0.z + w * (br.gqc1.z - br.gqc0.z);
+
+    const JulianDate jdate(ctx.day_start.day, ctx.day_start.fraction + t);
+    topocentric(ctx.obs, jdate, gqc, ctx.earth_radius, topo);
+}
+
+
+/*
+ *  Returns the amount by which the body is above the target altitude
+ *  at t days after the start of the day.
+ */
+
+double altitude_at(const SearchContext& ctx, const Bracket& br,
+                   const double t) {
+    TopoCoords topo;
+    topo_at(ctx, br, t, topo);
+    return altitude_offset(ctx, topo);
+}
+
+
+/*
+ *  Returns the hour angle of the body at t days after the start of
+ *  the day.
+ */
+
+double hour_angle_at(const SearchContext& ctx, const Bracket& br,
+                     const double t) {
+    TopoCoords topo;
+    topo_at(ctx, br, t, topo);
+    return topo.hour_angle;
+}
+
+
+/*
+ *  Returns the time within the supplied step at which func, which is
+ *  f0 and f1 at its ends and has different signs at each, is zero.
+ *
+ *  Uses the Illinois variant of the method of false position, as for
+ *  zodiac ingresses.
+ */
+
+double find_root(const SearchContext& ctx, const Bracket& br,
+                 const BracketFunc func, double f0, double f1) {
+    double t0 = br.t0;
+    double t1 = br.t1;
+    int side = 0;
+
+    for ( int i = 0; i < max_refine_iterations &&
+                     t1 - t0 > event_tolerance; ++i ) {
+        const double t = (f1 == f0) ? (t0 + t1) / 2 :
+                                      t1 - f1 * (t1 - t0) / (f1 - f0);
+        const double f = func(ctx, br, t);
+
+        if ( f == 0 ) {
+            return t;
+        } else if ( (f < 0) == (f0 < 0) ) {
+            t0 = t;
+            f0 = f;
+            if ( side == -1 ) {
+                f1 /= 2;
+            }
+            side = -1;
+        } else {
+            t1 = t;
+            f1 = f;
+            if ( side == 1 ) {
+                f0 /= 2;
+            }
+            side = 1;
+        }
+
+        //  Stop once the estimate is within tolerance of the root
+
+        if ( fabs(f) < 1e-7 ) {
+            return t;
+        }
+    }
+
+    return (t0 + t1) / 2;
+}
+
+}           //  namespace
@@ -0,0 +1,88 @@
+/*
+ *  rise_set.h
+ *  ==========
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to rise, transit and set time calculations.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_RISE_SET_H
+#define PG_ASTRO_RISE_SET_H
+
+#include "astro_common_types.h"
+#include "julian_date.h"
+#include "observer.h"
+
+namespace astro {
+
+/*
+ *  Constants
+ */
+
+//  Altitudes, in degrees, of the centre of a body when it rises or
+//  sets, allowing for refraction at the horizon, and for the Sun's
+//  semi-diameter. The Moon's semi-diameter varies with its distance,
+//  and is allowed for separately.
+
+constexpr double RISE_SET_ALTITUDE = -0.5667;
+constexpr double SUN_RISE_SET_ALTITUDE = -0.8333;
+
+//  Altitudes, in degrees, of the centre of the Sun at the beginning
+//  and end of twilight
+
+constexpr double CIVIL_TWILIGHT_ALTITUDE = -6;
+constexpr double NAUTICAL_TWILIGHT_ALTITUDE = -12;
+constexpr double ASTRONOMICAL_TWILIGHT_ALTITUDE = -18;
+
+
+enum Twilight {
+    TWILIGHT_CIVIL,
+    TWILIGHT_NAUTICAL,
+    TWILIGHT_ASTRONOMICAL
+};
+
+
+/*
+ *  The times at which a body rises, crosses the meridian and sets
+ *  during a day. For twilight, the rise and set times are those of
+ *  dawn and dusk.
+ */
+
+struct RiseTransitSet {
+    BodyId body;
+    double rise;            // Julian dates of the events, valid only
+    double transit;         // if the corresponding flag below is set
+    double set;
+    bool has_rise;
+    bool has_transit;
+    bool has_set;
+    bool always_above;      // True if above the altitude all day
+    bool always_below;      // True if below the altitude all day
+
+    RiseTransitSet() :
+        body(BODY_SUN), rise(0), transit(0), set(0),
+        has_rise(false), has_transit(false), has_set(false),
+        always_above(false), always_below(false) {}
+};
+
+
+/*
+ *  Function prototypes
+ */
+
+void rise_transit_set(const BodyId body, const Observer& obs,
+                      const JulianDate& day_start, RiseTransitSet& rts);
+void rise_transit_set(const BodyId body, const Observer& obs,
+                      const JulianDate& day_start, const double altitude,
+                      RiseTransitSet& rts);
+void sun_twilight(const Observer& obs, const JulianDate& day_start,
+                  const Twilight twilight, RiseTransitSet& rts);
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_RISE_SET_H
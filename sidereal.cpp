@@ -0,0 +1,171 @@
+/*
+ *  sidereal.cpp
+ *  ============
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of sidereal time and hour angle functions.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <cstddef>
+#include <cmath>
+#include <stdint.h>
+#include "astrofunc.h"
+#include "julian_date.h"
+#include "sidereal.h"
+
+using std::floor;
+using std::ceil;
+using std::fmod;
+
+using namespace astro;
+
+
+/*
+ *  Local constants
+ */
+
+namespace {
+
+//  Coefficients of the IAU 1982 expression for the Greenwich mean
+//  sidereal time, in degrees, from Meeus, Astronomical Algorithms
+
+const double gmst_at_j2000 = 280.46061837;
+const double gmst_t2 = 0.000387933;
+const double gmst_t3 = 38710000;
+
+}           //  namespace
+
+
+/*
+ *  Local function prototypes
+ */
+
+namespace {
+
+double gmst_from_days(const double whole, const double fraction);
+
+}           //  namespace
+
+
+/*
+ *  Returns the Greenwich mean sidereal time, in degrees in the range
+ *  0 <= gmst < 360, at the supplied Julian date of UT.
+ */
+
+double astro::gmst(const JulianDate& jdate) {
+    return gmst_from_days(jdate.day - EPOCH_J2000, jdate.fraction);
+}
+
+
+/*
+ *  Returns the local mean sidereal time, in degrees in the range
+ *  0 <= lst < 360, at the supplied Julian date of UT and longitude
+ *  in degrees, east positive.
+ */
+
+double astro::lst(const JulianDate& jdate, const double lon) {
+    return normalize_degrees(gmst(jdate) + lon);
+}
+
+
+/*
+ *  Calculates the Greenwich mean sidereal time at each of an array
+ *  of times.
+ *
+ *  Arguments:
+ *    secs - an array of times, in seconds since the Unix epoch
+ *    count - the number of elements in secs
+ *    gmsts - an array of at least count elements, in which the
+ *            sidereal times, in degrees, are stored
+ *
+ *  Each time is split into whole days and the time of day by
+ *  julian_date_from_unix(), so no precision is lost to the size of
+ *  the date.
+ */
+
+void astro::gmst_from_unix(const int64_t * secs, const size_t count,
+                           double * gmsts) {
+    for ( size_t i = 0; i < count; ++i ) {
+        gmsts[i] = gmst(julian_date_from_unix(secs[i]));
+    }
+}
+
+
+/*
+ *  Calculates the Greenwich mean sidereal time at count times spaced
+ *  step days apart, starting at the supplied time.
+ *
+ *  The sidereal time is evaluated in full only at the start, and
+ *  advanced at the constant rate of that time for the rest. The rate
+ *  changes by less than 1e-12 degrees per day each day, so the error
+ *  over a year of samples is below 1e-7 degrees.
+ */
+
+void astro::gmst_uniform(const JulianDate& start, const double step,
+                         const size_t count, double * gmsts) {
+    const double start_gmst = gmst(start);
+    const double jcents = start.centuries();
+    const double rate = SIDEREAL_RATE +
+                        2 * gmst_t2 * jcents / JDAYS_PER_CENT;
+    const double increment = fmod(rate * step, 360);
+
+    for ( size_t i = 0; i < count; ++i ) {
+        gmsts[i] = normalize_degrees(start_gmst + i * increment);
+    }
+}
+
+
+/*
+ *  Calculates the hour angles of a body at each of an array of times.
+ *
+ *  Arguments:
+ *    gmsts - an array of Greenwich mean sidereal times, in degrees
+ *    rasc - an array of the right ascensions of the body at the
+ *           same times, in degrees
+ *    count - the number of elements in gmsts and rasc
+ *    lon - the observer's longitude, in degrees, east positive
+ *    has - an array of at least count elements, in which the hour
+ *          angles, in degrees west in the range -180 < ha <= 180,
+ *          are stored
+ *
+ *  Only arithmetic is used, so the loop may be vectorized.
+ */
+
+void astro::hour_angles(const double * gmsts, const double * rasc,
+                        const size_t count, const double lon,
+                        double * has) {
+    for ( size_t i = 0; i < count; ++i ) {
+        const double ha = gmsts[i] + lon - rasc[i];
+        has[i] = ha - 360 * ceil((ha - 180) / 360);
+    }
+}
+
+
+namespace {
+
+/*
+ *  Returns the Greenwich mean sidereal time, in degrees, at whole +
+ *  fraction days since J2000.
+ *
+ *  The whole revolutions in 360 degrees per day are removed from the
+ *  whole days before adding the time of day, so the result loses no
+ *  precision to the size of the date.
+ */
+
+double gmst_from_days(const double whole, const double fraction) {
+    const double days = whole + fraction;
+    const double jcents = days / JDAYS_PER_CENT;
+    const double revs = (whole - floor(whole)) + fraction;
+
+    return normalize_degrees(gmst_at_j2000 + 360 * revs +
+                             (SIDEREAL_RATE - 360) * days +
+                             jcents * jcents *
+                             (gmst_t2 - jcents / gmst_t3));
+}
+
+}           //  namespace
@@ -0,0 +1,48 @@
+/*
+ *  sidereal.h
+ *  ==========
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to sidereal time and hour angle functions.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_SIDEREAL_H
+#define PG_ASTRO_SIDEREAL_H
+
+#include <cstddef>
+#include <stdint.h>
+#include "julian_date.h"
+
+namespace astro {
+
+/*
+ *  Constants
+ */
+
+//  Rate of the Greenwich mean sidereal time at J2000, in degrees per
+//  day of UT
+
+constexpr double SIDEREAL_RATE = 360.98564736629;
+
+
+/*
+ *  Function prototypes
+ */
+
+double gmst(const JulianDate& jdate);
+double lst(const JulianDate& jdate, const double lon);
+void gmst_from_unix(const int64_t * secs, const size_t count,
+                    double * gmsts);
+void gmst_uniform(const JulianDate& start, const double step,
+                  const size_t count, double * gmsts);
+void hour_angles(const double * gmsts, const double * rasc,
+                 const size_t count, const double lon, double * has);
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_SIDEREAL_H
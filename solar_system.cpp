@@ -0,0 +1,123 @@
+/*
+ *  solar_system.cpp
+ *  ================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of whole-solar-system position calculations.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <cassert>
+#include <paulgrif/utctime.h>
+#include "astro_common_types.h"
+#include "astrofunc.h"
+#include "julian_date.h"
+#include "major_body.h"
+#include "planets.h"
+#include "moon.h"
+#include "solar_system.h"
+
+using namespace astro;
+
+
+/*
+ *  Local function prototypes
+ */
+
+namespace {
+
+void set_position(const RectCoords& gec, BodyPosition& pos);
+
+}           //  namespace
+
+
+/*
+ *  Calculates the positions of all the bodies at the supplied
+ *  time, and stores the result in (and modifies) the supplied
+ *  SolarSystemSnapshot struct.
+ *
+ *  The heliocentric coordinates of the Earth are calculated only
+ *  once, and shared between all the bodies.
+ */
+
+void astro::solar_system_snapshot(const utctime::UTCTime& calc_time,
+                                  SolarSystemSnapshot& snap) {
+    solar_system_snapshot(julian_date_split(calc_time), snap);
+}
+
+
+/*
+ *  Calculates the positions of all the bodies at the supplied
+ *  Julian date, as above.
+ */
+
+void astro::solar_system_snapshot(const JulianDate& jdate,
+                                  SolarSystemSnapshot& snap) {
+    const RectCoords eec = Earth(jdate).helio_ecl_coords();
+
+    const Sun sun(jdate);
+    const Mercury mercury(jdate);
+    const Venus venus(jdate);
+    const Mars mars(jdate);
+    const Jupiter jupiter(jdate);
+    const Saturn saturn(jdate);
+    const Uranus uranus(jdate);
+    const Neptune neptune(jdate);
+    const Pluto pluto(jdate);
+
+    const MajorBody* major_bodies[] = {&sun, &mercury, &venus,
+                                       &mars, &jupiter, &saturn,
+                                       &uranus, &neptune, &pluto};
+
+    for ( int i = BODY_SUN; i <= BODY_PLUTO; ++i ) {
+        set_position(major_bodies[i]->geo_ecl_coords_from_earth(eec),
+                     snap.bodies[i]);
+    }
+
+    set_position(Moon(jdate).geo_ecl_coords(), snap.bodies[BODY_MOON]);
+
+    snap.jdate = jdate.value();
+}
+
+
+/*
+ *  Returns a pointer to a C string representation of the name
+ *  of the supplied body.
+ */
+
+const char * astro::body_name(const BodyId body) {
+    static const char * const body_names[] = {
+        "Sun", "Mercury", "Venus", "Mars", "Jupiter",
+        "Saturn", "Uranus", "Neptune", "Pluto", "Moon"
+    };
+
+    assert(body >= 0);
+    assert(body < NUM_BODIES);
+
+    return body_names[body];
+}
+
+
+namespace {
+
+/*
+ *  Calculates the equatorial position of a body from its geocentric
+ *  ecliptic coordinates, and stores the result in (and modifies) the
+ *  supplied BodyPosition struct.
+ */
+
+void set_position(const RectCoords& gec, BodyPosition& pos) {
+    SphCoords sph;
+    ecl_to_sph(gec, sph);
+
+    pos.right_ascension = sph.right_ascension;
+    pos.declination = sph.declination;
+    pos.distance = sph.distance;
+    pos.geo_ecl = gec;
+}
+
+}           //  namespace
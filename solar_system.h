@@ -0,0 +1,49 @@
+/*
+ *  solar_system.h
+ *  ==============
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to whole-solar-system position calculations.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_SOLAR_SYSTEM_H
+#define PG_ASTRO_SOLAR_SYSTEM_H
+
+#include <paulgrif/utctime.h>
+#include "astro_common_types.h"
+#include "julian_date.h"
+
+namespace astro {
+
+struct BodyPosition {
+    double right_ascension;
+    double declination;
+    double distance;
+    RectCoords geo_ecl;     // Geocentric ecliptic coordinates
+
+    BodyPosition() :
+        right_ascension(0), declination(0), distance(0), geo_ecl() {}
+};
+
+struct SolarSystemSnapshot {
+    double jdate;
+    BodyPosition bodies[NUM_BODIES];
+
+    SolarSystemSnapshot() :
+        jdate(0), bodies() {}
+};
+
+void solar_system_snapshot(const utctime::UTCTime& calc_time,
+                           SolarSystemSnapshot& snap);
+void solar_system_snapshot(const JulianDate& jdate,
+                           SolarSystemSnapshot& snap);
+const char * body_name(const BodyId body);
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_SOLAR_SYSTEM_H
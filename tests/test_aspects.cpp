@@ -0,0 +1,199 @@
+/*
+ *  test_aspects.cpp
+ *  ================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for aspect search functions.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <vector>
+#include <cmath>
+#include "../astro_common_types.h"
+#include "../astrofunc.h"
+#include "../body_time_series.h"
+#include "../aspects.h"
+
+using namespace astro;
+
+
+namespace {
+
+/*
+ *  Returns the geocentric ecliptic longitude of a body, in degrees.
+ */
+
+double longitude(const BodyTimeSeries& series, const double jdate) {
+    RectCoords gec, gev;
+    series.geo_ecl_state(jdate, gec, gev);
+    return normalize_degrees(degrees(std::atan2(gec.y, gec.x)));
+}
+
+}           //  namespace
+
+
+TEST_GROUP(AspectsGroup) {
+};
+
+
+/*
+ *  Tests the great conjunction of Jupiter and Saturn, at 18:20 UTC
+ *  on 21 December 2020, is found.
+ */
+
+TEST(AspectsGroup, GreatConjunctionTest) {
+    const BodyId bodies[] = {BODY_JUPITER, BODY_SATURN};
+    const double start_jd = 2458849.5;          //  2020-01-01
+
+    std::vector<AspectEvent> events;
+    find_aspects(bodies, 2, start_jd, start_jd + 366, events, 1);
+
+    int conjunctions = 0;
+    for ( size_t i = 0; i < events.size(); ++i ) {
+        if ( events[i].aspect == 0 ) {
+            ++conjunctions;
+            DOUBLES_EQUAL(2459205.264, events[i].jdate, 0.5);
+        }
+    }
+    CHECK_EQUAL(1, conjunctions);
+}
+
+
+/*
+ *  Tests the Sun and Moon conjunctions in 2013 are found at the new
+ *  moons, starting with 19:44 UTC on 11 January.
+ */
+
+TEST(AspectsGroup, NewMoonTest) {
+    const BodyId bodies[] = {BODY_SUN, BODY_MOON};
+    const double start_jd = 2456293.5;          //  2013-01-01
+
+    std::vector<AspectEvent> events;
+    find_aspects(bodies, 2, start_jd, start_jd + 365, events, 2);
+
+    std::vector<double> new_moons;
+    for ( size_t i = 0; i < events.size(); ++i ) {
+        if ( events[i].aspect == 0 ) {
+            new_moons.push_back(events[i].jdate);
+        }
+    }
+
+    CHECK_EQUAL(12, new_moons.size());
+    DOUBLES_EQUAL(2456304.322, new_moons[0], 0.05);
+    for ( size_t i = 1; i < new_moons.size(); ++i ) {
+        DOUBLES_EQUAL(29.53, new_moons[i] - new_moons[i - 1], 0.5);
+    }
+
+    //  Each of the eight separations is reached once a month
+
+    CHECK(events.size() >= 97);
+    CHECK(events.size() <= 100);
+}
+
+
+/*
+ *  Tests aspects between the Sun, Mercury, Mars and Neptune agree
+ *  with those found by a fine scan, are exact to within a second,
+ *  and are sorted, and that the results do not depend on the number
+ *  of threads.
+ */
+
+TEST(AspectsGroup, AspectsMatchScanTest) {
+    const BodyId bodies[] = {BODY_SUN, BODY_MERCURY, BODY_MARS,
+                             BODY_NEPTUNE};
+    const size_t num_bodies = sizeof(bodies) / sizeof(bodies[0]);
+    const double start_jd = 2456293.5;          //  2013-01-01
+    const double end_jd = start_jd + 2 * 365;
+    const double scan_step = 0.05;
+    const double targets[] = {0, 60, 90, 120, 180, 240, 270, 300};
+
+    std::vector<AspectEvent> events;
+    find_aspects(bodies, num_bodies, start_jd, end_jd, events, 1);
+
+    //  Count crossings of each target by scanning
+
+    size_t expected = 0;
+    for ( size_t a = 0; a < num_bodies; ++a ) {
+        const BodyTimeSeries first(bodies[a]);
+        for ( size_t b = a + 1; b < num_bodies; ++b ) {
+            const BodyTimeSeries second(bodies[b]);
+            double prev = 0;
+            for ( double t = start_jd; t <= end_jd; t += scan_step ) {
+                const double sep = normalize_degrees(longitude(first, t) -
+                                                     longitude(second, t));
+                if ( t > start_jd ) {
+                    for ( int k = 0; k < 8; ++k ) {
+                        const double d0 = normalize_degrees(prev -
+                                targets[k] + 180) - 180;
+                        const double d1 = normalize_degrees(sep -
+                                targets[k] + 180) - 180;
+                        if ( std::fabs(d0) < 10 && (d0 < 0) != (d1 < 0) ) {
+                            ++expected;
+                        }
+                    }
+                }
+                prev = sep;
+            }
+        }
+    }
+
+    CHECK_EQUAL(expected, events.size());
+
+    for ( size_t i = 0; i < events.size(); ++i ) {
+        if ( i > 0 ) {
+            CHECK(events[i - 1].jdate <= events[i].jdate);
+        }
+
+        const BodyTimeSeries first(events[i].first);
+        const BodyTimeSeries second(events[i].second);
+        const double sep = normalize_degrees(
+                longitude(first, events[i].jdate) -
+                longitude(second, events[i].jdate));
+        const double aspect = sep <= 180 ? sep : 360 - sep;
+
+        //  Separations change by at most a few degrees per day
+
+        DOUBLES_EQUAL(events[i].aspect, aspect, 1e-4);
+    }
+
+    //  Results are identical with several threads
+
+    std::vector<AspectEvent> threaded;
+    find_aspects(bodies, num_bodies, start_jd, end_jd, threaded, 3);
+
+    CHECK_EQUAL(events.size(), threaded.size());
+    for ( size_t i = 0; i < events.size() && i < threaded.size(); ++i ) {
+        DOUBLES_EQUAL(events[i].jdate, threaded[i].jdate, 0);
+        CHECK_EQUAL(events[i].first, threaded[i].first);
+        CHECK_EQUAL(events[i].second, threaded[i].second);
+        DOUBLES_EQUAL(events[i].aspect, threaded[i].aspect, 0);
+    }
+}
+
+
+/*
+ *  Tests longitude rates stay within their bounds.
+ */
+
+TEST(AspectsGroup, RateBoundTest) {
+    for ( int b = 0; b < NUM_BODIES; ++b ) {
+        const BodyId body = static_cast<BodyId>(b);
+        const BodyTimeSeries series(body);
+        const double bound = longitude_rate_bound(body);
+
+        for ( double t = 2440000.5; t < 2470000.5; t += 3.7 ) {
+            RectCoords gec, gev;
+            series.geo_ecl_state(t, gec, gev);
+            const double rate = degrees((gec.x * gev.y - gec.y * gev.x) /
+                                        (gec.x * gec.x + gec.y * gec.y));
+            CHECK(std::fabs(rate) < bound);
+        }
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ *  test_body_state.cpp
+ *  ===================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for BodyState and compute().
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include "../astro_common_types.h"
+#include "../astrofunc.h"
+#include "../julian_date.h"
+#include "../body_state.h"
+#include "../planets.h"
+#include "../moon.h"
+#include "../solar_system.h"
+
+using namespace astro;
+
+
+TEST_GROUP(BodyStateGroup) {
+};
+
+
+/*
+ *  Tests compute() gives the same positions as the Planet classes,
+ *  and as solar_system_snapshot(), for every body.
+ */
+
+TEST(BodyStateGroup, ComputeTest) {
+    const JulianDate jdate(2456293.5, 0.75);
+    SolarSystemSnapshot snap;
+    solar_system_snapshot(jdate, snap);
+
+    const double accuracy = 1e-11;
+    for ( int i = BODY_SUN; i < NUM_BODIES; ++i ) {
+        const BodyId body = static_cast<BodyId>(i);
+        BodyState state;
+        compute(body, jdate, state);
+
+        CHECK_EQUAL(body, state.body);
+        DOUBLES_EQUAL(jdate.value(), state.jdate, 0);
+
+        const BodyPosition& pos = snap.bodies[i];
+        DOUBLES_EQUAL(pos.right_ascension, state.right_ascension, accuracy);
+        DOUBLES_EQUAL(pos.declination, state.declination, accuracy);
+        DOUBLES_EQUAL(pos.distance, state.distance, accuracy);
+        DOUBLES_EQUAL(pos.geo_ecl.x, state.geo_ecl[0], accuracy);
+        DOUBLES_EQUAL(pos.geo_ecl.y, state.geo_ecl[1], accuracy);
+        DOUBLES_EQUAL(pos.geo_ecl.z, state.geo_ecl[2], accuracy);
+    }
+
+    BodyState state;
+    compute(BODY_JUPITER, jdate, state);
+    const Jupiter jupiter(jdate);
+    DOUBLES_EQUAL(jupiter.right_ascension(), state.right_ascension,
+                  accuracy);
+    DOUBLES_EQUAL(jupiter.declination(), state.declination, accuracy);
+    DOUBLES_EQUAL(jupiter.distance(), state.distance, accuracy);
+
+    compute(BODY_MOON, jdate, state);
+    const Moon moon(jdate);
+    DOUBLES_EQUAL(moon.right_ascension(), state.right_ascension, 1e-9);
+    DOUBLES_EQUAL(moon.declination(), state.declination, 1e-9);
+    DOUBLES_EQUAL(moon.distance(), state.distance, 1e-9);
+
+    BodyState from_double;
+    compute(BODY_MARS, 2456294.25, from_double);
+    compute(BODY_MARS, jdate, state);
+    DOUBLES_EQUAL(state.right_ascension, from_double.right_ascension,
+                  1e-9);
+    DOUBLES_EQUAL(state.declination, from_double.declination, 1e-9);
+}
+
+
+/*
+ *  Tests the Planet classes share the calculation of compute(), so
+ *  that their positions are identical, not merely close.
+ */
+
+TEST(BodyStateGroup, PlanetClassesTest) {
+    const JulianDate jdate(2456293.5, 0.75);
+
+    const Sun sun(jdate);
+    const Mercury mercury(jdate);
+    const Venus venus(jdate);
+    const Mars mars(jdate);
+    const Jupiter jupiter(jdate);
+    const Saturn saturn(jdate);
+    const Uranus uranus(jdate);
+    const Neptune neptune(jdate);
+    const Pluto pluto(jdate);
+    const Moon moon(jdate);
+
+    const Planet * planets[NUM_BODIES] = {&sun, &mercury, &venus, &mars,
+                                          &jupiter, &saturn, &uranus,
+                                          &neptune, &pluto, &moon};
+
+    for ( int i = BODY_SUN; i < NUM_BODIES; ++i ) {
+        RectCoords gec;
+        geo_ecl_coords(static_cast<BodyId>(i), jdate, gec);
+
+        const RectCoords expected = planets[i]->geo_ecl_coords();
+        CHECK_EQUAL(expected.x, gec.x);
+        CHECK_EQUAL(expected.y, gec.y);
+        CHECK_EQUAL(expected.z, gec.z);
+    }
+}
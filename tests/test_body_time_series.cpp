@@ -0,0 +1,110 @@
+/*
+ *  test_body_time_series.cpp
+ *  =========================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for BodyTimeSeries class.
+ *
+ *  The time series should give the same results as calculating
+ *  each time individually with the corresponding Planet class.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <paulgrif/utctime.h>
+#include "../astro.h"
+
+using namespace astro;
+
+
+TEST_GROUP(BodyTimeSeriesGroup) {
+};
+
+
+/*
+ *  Tests time series for Mars, the Sun and the Moon against individual
+ *  calculations at several times.
+ */
+
+TEST(BodyTimeSeriesGroup, TimeSeriesTest) {
+    const double accuracy = 0.0000001;
+    const utctime::UTCTime times[] = {
+        utctime::UTCTime(1947, 12, 1, 12, 0, 0),
+        utctime::UTCTime(1980, 5, 5, 20, 23, 0),
+        utctime::UTCTime(1997, 6, 21, 0, 0, 0),
+        utctime::UTCTime(2013, 6, 4, 1, 15, 0)
+    };
+    const size_t count = sizeof(times) / sizeof(times[0]);
+
+    double jdates[count];
+    for ( size_t i = 0; i < count; ++i ) {
+        jdates[i] = julian_date(times[i]);
+    }
+
+    double rasc[count], decl[count], dist[count];
+
+    BodyTimeSeries(BODY_MARS).calculate(jdates, count, rasc, decl, dist);
+    for ( size_t i = 0; i < count; ++i ) {
+        const Mars mars(times[i]);
+        DOUBLES_EQUAL(mars.right_ascension(), rasc[i], accuracy);
+        DOUBLES_EQUAL(mars.declination(), decl[i], accuracy);
+        DOUBLES_EQUAL(mars.distance(), dist[i], accuracy);
+    }
+
+    BodyTimeSeries(BODY_SUN).calculate(jdates, count, rasc, decl, dist);
+    for ( size_t i = 0; i < count; ++i ) {
+        const Sun sun(times[i]);
+        DOUBLES_EQUAL(sun.right_ascension(), rasc[i], accuracy);
+        DOUBLES_EQUAL(sun.declination(), decl[i], accuracy);
+        DOUBLES_EQUAL(sun.distance(), dist[i], accuracy);
+    }
+
+    BodyTimeSeries(BODY_MOON).calculate(jdates, count, rasc, decl, dist);
+    for ( size_t i = 0; i < count; ++i ) {
+        const Moon moon(times[i]);
+        DOUBLES_EQUAL(moon.right_ascension(), rasc[i], accuracy);
+        DOUBLES_EQUAL(moon.declination(), decl[i], accuracy);
+        DOUBLES_EQUAL(moon.distance(), dist[i], accuracy);
+    }
+}
+
+
+/*
+ *  Tests geocentric ecliptic state for Jupiter and the Sun, with the
+ *  position checked against geo_equ_coords() and the velocity
+ *  checked against differenced positions.
+ */
+
+TEST(BodyTimeSeriesGroup, GeoEclStateTest) {
+    const double step = 0.001;
+    const BodyId bodies[] = {BODY_SUN, BODY_JUPITER};
+
+    for ( int b = 0; b < 2; ++b ) {
+        const BodyTimeSeries series(bodies[b]);
+
+        for ( double jd = 2440000.5; jd < 2470000; jd += 2345.6 ) {
+            RectCoords gec, gev;
+            series.geo_ecl_state(jd, gec, gev);
+
+            RectCoords gqc, gqs;
+            series.geo_equ_coords(&jd, 1, &gqc);
+            ecl_to_equ(gec, gqs);
+            DOUBLES_EQUAL(gqc.x, gqs.x, 1e-12);
+            DOUBLES_EQUAL(gqc.y, gqs.y, 1e-12);
+            DOUBLES_EQUAL(gqc.z, gqs.z, 1e-12);
+
+            RectCoords before, after, unused;
+            series.geo_ecl_state(jd - step, before, unused);
+            series.geo_ecl_state(jd + step, after, unused);
+            DOUBLES_EQUAL((after.x - before.x) / (2 * step), gev.x, 1e-8);
+            DOUBLES_EQUAL((after.y - before.y) / (2 * step), gev.y, 1e-8);
+            DOUBLES_EQUAL((after.z - before.z) / (2 * step), gev.z, 1e-8);
+        }
+    }
+}
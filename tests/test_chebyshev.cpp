@@ -0,0 +1,70 @@
+/*
+ *  test_chebyshev.cpp
+ *  ==================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for ChebyshevEphemeris class.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <paulgrif/utctime.h>
+#include "../astro.h"
+
+using namespace astro;
+
+
+TEST_GROUP(ChebyshevGroup) {
+};
+
+
+/*
+ *  Tests cached position of Mercury against direct calculation
+ *  for May 5, 1980, 20:23 UTC, and checks that the maximum error
+ *  over the cached year is less than one arcsecond.
+ */
+
+TEST(ChebyshevGroup, MercuryTest) {
+    const utctime::UTCTime utc(1980, 5, 5, 20, 23, 0);
+    const double jdate = julian_date(utc);
+    const double accuracy = 0.00001;
+
+    const ChebyshevEphemeris cheb(BODY_MERCURY, jdate - 180,
+                                  jdate + 180, 8, 12);
+
+    SphCoords cds;
+    cheb.spherical(jdate, cds);
+
+    const Mercury mercury(utc);
+    DOUBLES_EQUAL(mercury.right_ascension(), cds.right_ascension, accuracy);
+    DOUBLES_EQUAL(mercury.declination(), cds.declination, accuracy);
+    DOUBLES_EQUAL(mercury.distance(), cds.distance, accuracy);
+
+    CHECK(cheb.max_error(16) < 1.0 / 3600);
+    CHECK(cheb.end_jd() >= jdate + 180);
+}
+
+
+/*
+ *  Tests that a slow-moving body can use long intervals, and that
+ *  positions at the very start and end of the cache are available.
+ */
+
+TEST(ChebyshevGroup, PlutoTest) {
+    const double start_jd = 2415020.5;
+    const ChebyshevEphemeris cheb(BODY_PLUTO, start_jd,
+                                  start_jd + 36525, 64, 10);
+
+    CHECK(cheb.max_error(8) < 1.0 / 3600);
+
+    SphCoords cds;
+    cheb.spherical(cheb.start_jd(), cds);
+    cheb.spherical(cheb.end_jd(), cds);
+    CHECK(cds.distance > 28);
+}
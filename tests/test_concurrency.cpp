@@ -0,0 +1,132 @@
+/*
+ *  test_concurrency.cpp
+ *  ====================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Stress test for concurrent calculation from multiple threads.
+ *
+ *  The threads are released together by a barrier, so that their
+ *  first calculations are concurrent, and their results are compared
+ *  afterwards with those calculated by a single thread. This test is
+ *  built as a separate executable, so that no other test has used
+ *  the library first. Run with "make tsan" to check for data races,
+ *  including in first-use initialization, with ThreadSanitizer.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <pthread.h>
+#include <paulgrif/utctime.h>
+#include "../astro.h"
+
+using namespace astro;
+
+
+namespace {
+
+const int num_threads = 8;
+const int num_rounds = 20;
+const int num_times = 4;
+
+const utctime::UTCTime times[num_times] = {
+    utctime::UTCTime(1947, 12, 1, 12, 0, 0),
+    utctime::UTCTime(1980, 5, 5, 20, 23, 0),
+    utctime::UTCTime(1997, 6, 21, 0, 0, 0),
+    utctime::UTCTime(2013, 6, 4, 1, 15, 0)
+};
+
+//  Results calculated by each thread
+
+struct ThreadResults {
+    double jdate[num_rounds][num_times];
+    double mars[num_rounds][num_times];
+    double moon[num_rounds][num_times];
+    double rasc[num_rounds][num_times][NUM_BODIES];
+};
+
+ThreadResults results[num_threads];
+pthread_barrier_t start_barrier;
+
+
+/*
+ *  Thread function, which waits for all the threads to be ready and
+ *  then calculates positions, storing them in its argument.
+ */
+
+extern "C" void * stress_thread(void * arg) {
+    ThreadResults& res = *static_cast<ThreadResults *>(arg);
+
+    pthread_barrier_wait(&start_barrier);
+
+    for ( int r = 0; r < num_rounds; ++r ) {
+        for ( int t = 0; t < num_times; ++t ) {
+            res.jdate[r][t] = julian_date(times[t]);
+            res.mars[r][t] = Mars(times[t]).right_ascension();
+            res.moon[r][t] = Moon(times[t]).right_ascension();
+
+            SolarSystemSnapshot snap;
+            solar_system_snapshot(times[t], snap);
+            for ( int b = 0; b < NUM_BODIES; ++b ) {
+                res.rasc[r][t][b] = snap.bodies[b].right_ascension;
+            }
+        }
+    }
+
+    return 0;
+}
+
+}           //  namespace
+
+
+TEST_GROUP(ConcurrencyGroup) {
+};
+
+
+/*
+ *  Tests that calculations in several threads at once give the
+ *  same results as in a single thread.
+ */
+
+TEST(ConcurrencyGroup, StressTest) {
+    pthread_t threads[num_threads];
+
+    LONGS_EQUAL(0, pthread_barrier_init(&start_barrier, 0, num_threads));
+    for ( int i = 0; i < num_threads; ++i ) {
+        LONGS_EQUAL(0, pthread_create(&threads[i], 0, stress_thread,
+                                      &results[i]));
+    }
+    for ( int i = 0; i < num_threads; ++i ) {
+        pthread_join(threads[i], 0);
+    }
+    pthread_barrier_destroy(&start_barrier);
+
+    //  Calculate the expected results in this thread only now, so
+    //  that the other threads were the first to use the library.
+
+    for ( int t = 0; t < num_times; ++t ) {
+        const double jdate = julian_date(times[t]);
+        const double mars = Mars(times[t]).right_ascension();
+        const double moon = Moon(times[t]).right_ascension();
+
+        SolarSystemSnapshot snap;
+        solar_system_snapshot(times[t], snap);
+
+        for ( int i = 0; i < num_threads; ++i ) {
+            for ( int r = 0; r < num_rounds; ++r ) {
+                CHECK_EQUAL(jdate, results[i].jdate[r][t]);
+                CHECK_EQUAL(mars, results[i].mars[r][t]);
+                CHECK_EQUAL(moon, results[i].moon[r][t]);
+                for ( int b = 0; b < NUM_BODIES; ++b ) {
+                    CHECK_EQUAL(snap.bodies[b].right_ascension,
+                                results[i].rasc[r][t][b]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ *  test_ecl_to_sph.cpp
+ *  ===================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for ecliptic to spherical coordinate conversion.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <cmath>
+#include <vector>
+#include "../astro_common_types.h"
+#include "../astrofunc.h"
+
+using namespace astro;
+
+
+TEST_GROUP(EclToSphGroup) {
+};
+
+
+/*
+ *  Tests the precomputed obliquity constants.
+ */
+
+TEST(EclToSphGroup, ObliquityTest) {
+    DOUBLES_EQUAL(cos(OBLIQUITY), COS_OBLIQUITY, 1e-16);
+    DOUBLES_EQUAL(sin(OBLIQUITY), SIN_OBLIQUITY, 1e-16);
+}
+
+
+/*
+ *  Tests ecl_to_sph() agrees with ecl_to_equ() followed by
+ *  rec_to_sph(), and the array version is identical to it.
+ */
+
+TEST(EclToSphGroup, ConversionTest) {
+    const size_t count = 1000;
+    std::vector<RectCoords> ecl(count);
+    for ( size_t i = 0; i < count; ++i ) {
+        ecl[i].x = 30 * cos(i * 0.37) + 0.1;
+        ecl[i].y = 20 * sin(i * 0.53);
+        ecl[i].z = 5 * sin(i * 0.11) - 1;
+    }
+
+    std::vector<double> rasc(count), decl(count), dist(count);
+    ecl_to_sph(&ecl[0], count, &rasc[0], &decl[0], &dist[0]);
+
+    const double accuracy = 1e-11;
+    for ( size_t i = 0; i < count; ++i ) {
+        RectCoords equ;
+        ecl_to_equ(ecl[i], equ);
+        SphCoords expected;
+        rec_to_sph(equ, expected);
+
+        SphCoords sph;
+        ecl_to_sph(ecl[i], sph);
+        DOUBLES_EQUAL(expected.right_ascension, sph.right_ascension,
+                      accuracy);
+        DOUBLES_EQUAL(expected.declination, sph.declination, accuracy);
+        DOUBLES_EQUAL(expected.distance, sph.distance, accuracy);
+
+        CHECK_EQUAL(sph.right_ascension, rasc[i]);
+        CHECK_EQUAL(sph.declination, decl[i]);
+        CHECK_EQUAL(sph.distance, dist[i]);
+    }
+}
+
+
+/*
+ *  Tests conversion of the poles.
+ */
+
+TEST(EclToSphGroup, PolesTest) {
+    RectCoords ecl;
+    ecl.z = 2;
+
+    SphCoords sph;
+    ecl_to_sph(ecl, sph);
+    DOUBLES_EQUAL(-90, sph.right_ascension, 1e-12);
+    DOUBLES_EQUAL(90 - degrees(OBLIQUITY), sph.declination, 1e-12);
+    DOUBLES_EQUAL(2, sph.distance, 1e-12);
+
+    RectCoords equ;
+    equ.z = -3;
+    rec_to_sph(equ, sph);
+    DOUBLES_EQUAL(-90, sph.declination, 1e-12);
+    DOUBLES_EQUAL(3, sph.distance, 1e-12);
+}
@@ -0,0 +1,87 @@
+/*
+ *  test_element_tables.cpp
+ *  =======================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for compile-time orbital element tables and templated
+ *  body evaluation.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include "../astro_common_types.h"
+#include "../astrofunc.h"
+#include "../julian_date.h"
+#include "../element_tables.h"
+#include "../planets.h"
+
+using namespace astro;
+
+
+TEST_GROUP(ElementTablesGroup) {
+};
+
+
+/*
+ *  Tests the tables are constant expressions, converted to radians.
+ */
+
+TEST(ElementTablesGroup, ConstexprTest) {
+    constexpr double mars_ml = MAJOR_BODY_ELEMENTS[BODY_MARS].j2000.ml;
+    static_assert(mars_ml == radians(-4.55343205),
+                  "Mars mean longitude not converted at compile time");
+    constexpr OrbElem rates = element_rates(EARTH_ELEMENTS);
+    static_assert(rates.ml > 0, "Earth rates not constant");
+
+    DOUBLES_EQUAL(radians(-4.55343205), mars_ml, 1e-15);
+    DOUBLES_EQUAL(radians(0.32327364) / JDAYS_PER_CENT, rates.lp, 1e-20);
+    DOUBLES_EQUAL(0, MAJOR_BODY_ELEMENTS[BODY_SUN].century.ml, 0);
+
+    //  Pluto's elements 0.137 Julian centuries after J2000, calculated
+    //  by hand from the published J2000 elements and rates
+
+    const OrbElem oes = orbital_elements<BODY_PLUTO>(0.137);
+    DOUBLES_EQUAL(39.48207346348, oes.sma, 1e-11);
+    DOUBLES_EQUAL(0.24883438290, oes.ecc, 1e-11);
+    DOUBLES_EQUAL(radians(17.14001866066), oes.inc, 1e-12);
+    DOUBLES_EQUAL(radians(34.75915757609), oes.man, 1e-12);
+    DOUBLES_EQUAL(radians(113.76103458980), oes.arp, 1e-12);
+}
+
+
+/*
+ *  Tests evaluate() gives the same positions as the Planet classes.
+ */
+
+TEST(ElementTablesGroup, EvaluateTest) {
+    const JulianDate jdate(2456500.5, 0.3125);
+    const double accuracy = 1e-11;
+
+    SphCoords scd;
+    evaluate<BODY_MARS>(jdate, scd);
+    const Mars mars(jdate);
+    DOUBLES_EQUAL(mars.right_ascension(), scd.right_ascension,
+                  accuracy);
+    DOUBLES_EQUAL(mars.declination(), scd.declination, accuracy);
+    DOUBLES_EQUAL(mars.distance(), scd.distance, accuracy);
+
+    evaluate<BODY_SUN>(jdate, scd);
+    const Sun sun(jdate);
+    DOUBLES_EQUAL(sun.right_ascension(), scd.right_ascension,
+                  accuracy);
+    DOUBLES_EQUAL(sun.declination(), scd.declination, accuracy);
+    DOUBLES_EQUAL(sun.distance(), scd.distance, accuracy);
+
+    RectCoords gec;
+    geo_ecl_coords<BODY_NEPTUNE>(jdate, gec);
+    const RectCoords expected = Neptune(jdate).geo_ecl_coords();
+    DOUBLES_EQUAL(expected.x, gec.x, accuracy);
+    DOUBLES_EQUAL(expected.y, gec.y, accuracy);
+    DOUBLES_EQUAL(expected.z, gec.z, accuracy);
+}
@@ -0,0 +1,106 @@
+/*
+ *  test_ephemeris_file.cpp
+ *  =======================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for binary ephemeris files.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <vector>
+#include <cstdio>
+#include <fstream>
+#include "../astro.h"
+
+using namespace astro;
+
+
+TEST_GROUP(EphemerisFileGroup) {
+};
+
+
+/*
+ *  Tests that positions read from a written file are identical
+ *  to those from the caches from which it was written.
+ */
+
+TEST(EphemerisFileGroup, RoundTripTest) {
+    const char * filename = "test_round_trip.eph";
+    const double start_jd = 2451545;
+
+    const ChebyshevEphemeris mars(BODY_MARS, start_jd,
+                                  start_jd + 365, 16, 12);
+    const ChebyshevEphemeris saturn(BODY_SATURN, start_jd,
+                                    start_jd + 365, 32, 10);
+
+    std::vector<ChebyshevSegment> segments;
+    segments.push_back(mars.segment());
+    segments.push_back(saturn.segment());
+    write_ephemeris_file(filename, segments);
+
+    {
+        const EphemerisFile efile(filename);
+        LONGS_EQUAL(2, efile.num_segments());
+
+        for ( double jd = start_jd; jd < start_jd + 365; jd += 7.3 ) {
+            RectCoords expected, test_result;
+
+            mars.geo_equ_coords(jd, expected);
+            CHECK(efile.geo_equ_coords(BODY_MARS, jd, test_result));
+            DOUBLES_EQUAL(expected.x, test_result.x, 0);
+            DOUBLES_EQUAL(expected.y, test_result.y, 0);
+            DOUBLES_EQUAL(expected.z, test_result.z, 0);
+
+            saturn.geo_equ_coords(jd, expected);
+            CHECK(efile.geo_equ_coords(BODY_SATURN, jd, test_result));
+            DOUBLES_EQUAL(expected.x, test_result.x, 0);
+            DOUBLES_EQUAL(expected.y, test_result.y, 0);
+            DOUBLES_EQUAL(expected.z, test_result.z, 0);
+        }
+
+        SphCoords sph;
+        CHECK_FALSE(efile.spherical(BODY_VENUS, start_jd, sph));
+        CHECK_FALSE(efile.spherical(BODY_MARS, start_jd - 1, sph));
+    }
+
+    std::remove(filename);
+}
+
+
+/*
+ *  Tests that invalid files are rejected.
+ */
+
+TEST(EphemerisFileGroup, InvalidFileTest) {
+    const char * filename = "test_invalid.eph";
+    bool thrown = false;
+
+    try {
+        const EphemerisFile efile("no_such_file.eph");
+    } catch(EphemerisFileException&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    {
+        std::ofstream out(filename);
+        out << "This is not an ephemeris file.";
+    }
+
+    thrown = false;
+    try {
+        const EphemerisFile efile(filename);
+    } catch(EphemerisFileException&) {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    std::remove(filename);
+}
@@ -0,0 +1,74 @@
+/*
+ *  test_ephemeris_generator.cpp
+ *  ============================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for generate_positions() function.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <vector>
+#include "../astro.h"
+
+using namespace astro;
+
+
+TEST_GROUP(EphemerisGeneratorGroup) {
+};
+
+
+/*
+ *  Tests that positions are identical for different numbers of
+ *  threads, and identical to those from a single time series.
+ */
+
+TEST(EphemerisGeneratorGroup, ThreadCountTest) {
+    const double start_jd = 2451545;
+    const double step_days = 0.37;
+    const size_t count = 5000;
+    const int thread_counts[] = {1, 3, 8};
+    const BodyId bodies[] = {BODY_SUN, BODY_MERCURY, BODY_PLUTO};
+
+    std::vector<double> expected(3 * count);
+    std::vector<double> jdates(count);
+    for ( size_t i = 0; i < count; ++i ) {
+        jdates[i] = start_jd + i * step_days;
+    }
+
+    for ( int t = 0; t < 3; ++t ) {
+        std::vector<double> results[3][3];
+        PositionArrays outputs[NUM_BODIES];
+
+        for ( int b = 0; b < 3; ++b ) {
+            for ( int c = 0; c < 3; ++c ) {
+                results[b][c].resize(count);
+            }
+            outputs[bodies[b]].rasc = &results[b][0][0];
+            outputs[bodies[b]].decl = &results[b][1][0];
+            outputs[bodies[b]].dist = &results[b][2][0];
+        }
+
+        generate_positions(start_jd, step_days, count,
+                           outputs, thread_counts[t]);
+
+        for ( int b = 0; b < 3; ++b ) {
+            BodyTimeSeries(bodies[b]).calculate(&jdates[0], count,
+                                                &expected[0],
+                                                &expected[count],
+                                                &expected[2 * count]);
+
+            for ( size_t i = 0; i < count; ++i ) {
+                DOUBLES_EQUAL(expected[i], results[b][0][i], 0);
+                DOUBLES_EQUAL(expected[count + i], results[b][1][i], 0);
+                DOUBLES_EQUAL(expected[2 * count + i], results[b][2][i], 0);
+            }
+        }
+    }
+}
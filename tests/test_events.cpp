@@ -0,0 +1,235 @@
+/*
+ *  test_events.cpp
+ *  ===============
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for astronomical event search functions.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <vector>
+#include <stdint.h>
+#include "../astro_common_types.h"
+#include "../astrofunc.h"
+#include "../body_time_series.h"
+#include "../zodiac.h"
+#include "../events.h"
+
+using namespace astro;
+
+
+TEST_GROUP(EventsGroup) {
+};
+
+
+/*
+ *  Tests the Sun's ingress into Aries is at the March 2013 equinox,
+ *  20 March 2013 11:02 UTC, and that it enters each sign in turn.
+ *
+ *  Positions are referred to the J2000 equinox, which by 2013 has
+ *  precessed by about 0.18 degrees, delaying the ingress by about
+ *  4.4 hours.
+ */
+
+TEST(EventsGroup, SunIngressTest) {
+    const double start_jd = 2456365.5;          //  2013-03-14
+    std::vector<ZodiacIngress> ingresses;
+    find_zodiac_ingresses(BODY_SUN, start_jd, start_jd + 365, ingresses);
+
+    CHECK_EQUAL(12, ingresses.size());
+    CHECK_EQUAL(0, ingresses[0].sign_index);
+    DOUBLES_EQUAL(2456371.959 + 0.183, ingresses[0].jdate, 0.01);
+
+    for ( size_t i = 0; i < ingresses.size(); ++i ) {
+        CHECK_EQUAL(BODY_SUN, ingresses[i].body);
+        CHECK_EQUAL(static_cast<int>(i), ingresses[i].sign_index);
+        CHECK(!ingresses[i].retrograde);
+    }
+}
+
+
+/*
+ *  Tests ingresses for Mars, including retrograde ones, agree with
+ *  those found by a fine scan, and are accurate to sub-second
+ *  precision.
+ */
+
+TEST(EventsGroup, MarsIngressMatchesScanTest) {
+    const double start_jd = 2457388.5;          //  2016-01-01
+    const double end_jd = start_jd + 2 * 365;
+    const double scan_step = 0.01;
+
+    std::vector<ZodiacIngress> ingresses;
+    find_zodiac_ingresses(BODY_MARS, start_jd, end_jd, ingresses);
+
+    const size_t count = (end_jd - start_jd) / scan_step + 1;
+    std::vector<double> jdates(count), rasc(count), decl(count), dist(count);
+    for ( size_t i = 0; i < count; ++i ) {
+        jdates[i] = start_jd + i * scan_step;
+    }
+    const BodyTimeSeries series(BODY_MARS);
+    series.calculate(&jdates[0], count, &rasc[0], &decl[0], &dist[0]);
+
+    std::vector<uint8_t> signs(count);
+    classify_zodiac(&rasc[0], &signs[0], 0, count);
+    std::vector<size_t> changes(count - 1);
+    const size_t num_changes = zodiac_ingresses(&signs[0], count,
+                                                &changes[0]);
+
+    CHECK_EQUAL(num_changes, ingresses.size());
+
+    int num_retrograde = 0;
+    for ( size_t i = 0; i < ingresses.size(); ++i ) {
+        const size_t c = changes[i];
+        CHECK_EQUAL(signs[c], ingresses[i].sign_index);
+        CHECK(ingresses[i].jdate >= jdates[c - 1]);
+        CHECK(ingresses[i].jdate <= jdates[c]);
+        num_retrograde += ingresses[i].retrograde;
+
+        //  Check the boundary is crossed within a second either side
+
+        const double second = 1.0 / 86400;
+        const double times[] = {ingresses[i].jdate - second,
+                                ingresses[i].jdate + second};
+        double r[2], d[2], s[2];
+        series.calculate(times, 2, r, d, s);
+        uint8_t sides[2];
+        classify_zodiac(r, sides, 0, 2);
+        CHECK_EQUAL(ingresses[i].sign_index, sides[1]);
+        CHECK(sides[0] != sides[1]);
+    }
+
+    //  Mars is retrograde in 2016 from April to June, and crosses
+    //  back from Sagittarius into Scorpio in that time.
+
+    CHECK(num_retrograde > 0);
+}
+
+
+/*
+ *  Tests Mercury's stations in 2013 against published times, which
+ *  were:
+ *
+ *    retrograde 23 February 08:42 UTC, direct 17 March 20:05 UTC
+ *    retrograde 26 June 13:08 UTC, direct 20 July 15:23 UTC
+ *    retrograde 21 October 10:30 UTC, direct 10 November 21:11 UTC
+ *
+ *  and that the longitude rate changes sign either side of each.
+ */
+
+TEST(EventsGroup, MercuryStationsTest) {
+    const double expected[] = {2456346.863, 2456369.337, 2456470.047,
+                               2456494.141, 2456586.938, 2456607.383};
+    const double start_jd = 2456293.5;          //  2013-01-01
+
+    std::vector<Station> stations;
+    find_stations(BODY_MERCURY, start_jd, start_jd + 365, stations);
+
+    CHECK_EQUAL(6, stations.size());
+
+    const BodyTimeSeries series(BODY_MERCURY);
+    const double second = 1.0 / 86400;
+
+    for ( size_t i = 0; i < stations.size(); ++i ) {
+        CHECK_EQUAL(BODY_MERCURY, stations[i].body);
+        CHECK_EQUAL(i % 2 == 0, stations[i].retrograde);
+        DOUBLES_EQUAL(expected[i], stations[i].jdate, 0.15);
+
+        const double before = longitude_rate(series,
+                                             stations[i].jdate - second);
+        const double after = longitude_rate(series,
+                                            stations[i].jdate + second);
+        CHECK_EQUAL(stations[i].retrograde, before > 0);
+        CHECK_EQUAL(stations[i].retrograde, after < 0);
+    }
+}
+
+
+/*
+ *  Tests motion intervals for Saturn cover the search period and
+ *  alternate between direct and retrograde.
+ */
+
+TEST(EventsGroup, MotionIntervalsTest) {
+    const double start_jd = 2456293.5;          //  2013-01-01
+    const double end_jd = start_jd + 3 * 365;
+
+    std::vector<MotionInterval> intervals;
+    find_motion_intervals(BODY_SATURN, start_jd, end_jd, intervals);
+
+    CHECK_EQUAL(7, intervals.size());
+    DOUBLES_EQUAL(start_jd, intervals.front().start_jd, 0);
+    DOUBLES_EQUAL(end_jd, intervals.back().end_jd, 0);
+
+    const BodyTimeSeries series(BODY_SATURN);
+    for ( size_t i = 0; i < intervals.size(); ++i ) {
+        CHECK(intervals[i].end_jd > intervals[i].start_jd);
+        if ( i > 0 ) {
+            DOUBLES_EQUAL(intervals[i - 1].end_jd, intervals[i].start_jd, 0);
+            CHECK(intervals[i - 1].retrograde != intervals[i].retrograde);
+        }
+
+        const double mid = (intervals[i].start_jd + intervals[i].end_jd) / 2;
+        CHECK_EQUAL(intervals[i].retrograde, longitude_rate(series, mid) < 0);
+    }
+
+    //  The Sun is never retrograde
+
+    intervals.clear();
+    find_motion_intervals(BODY_SUN, start_jd, end_jd, intervals);
+    CHECK_EQUAL(1, intervals.size());
+    CHECK(!intervals[0].retrograde);
+
+    //  Nor is the Moon
+
+    intervals.clear();
+    find_motion_intervals(BODY_MOON, start_jd, start_jd + 60, intervals);
+    CHECK_EQUAL(1, intervals.size());
+    CHECK(!intervals[0].retrograde);
+}
+
+
+/*
+ *  Tests the Moon enters each sign in turn, every two to three days,
+ *  with the boundary crossed within a second of each ingress.
+ */
+
+TEST(EventsGroup, MoonIngressTest) {
+    const double start_jd = 2456293.5;          //  2013-01-01
+    const double end_jd = start_jd + 90;
+
+    std::vector<ZodiacIngress> ingresses;
+    find_zodiac_ingresses(BODY_MOON, start_jd, end_jd, ingresses);
+
+    CHECK(ingresses.size() >= 39);
+    CHECK(ingresses.size() <= 41);
+
+    const BodyTimeSeries series(BODY_MOON);
+    const double second = 1.0 / 86400;
+
+    for ( size_t i = 0; i < ingresses.size(); ++i ) {
+        CHECK(!ingresses[i].retrograde);
+        if ( i > 0 ) {
+            CHECK_EQUAL((ingresses[i - 1].sign_index + 1) % 12,
+                        ingresses[i].sign_index);
+            const double gap = ingresses[i].jdate - ingresses[i - 1].jdate;
+            CHECK(gap > 1.5 && gap < 3.5);
+        }
+
+        const double times[] = {ingresses[i].jdate - second,
+                                ingresses[i].jdate + second};
+        double r[2], d[2], s[2];
+        series.calculate(times, 2, r, d, s);
+        uint8_t sides[2];
+        classify_zodiac(r, sides, 0, 2);
+        CHECK_EQUAL(ingresses[i].sign_index, sides[1]);
+        CHECK(sides[0] != sides[1]);
+    }
+}
@@ -0,0 +1,215 @@
+/*
+ *  test_formatting.cpp
+ *  ===================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for char buffer formatting functions.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include "../astrofunc.h"
+#include "../solar_system.h"
+#include "../planet_func.h"
+
+using namespace astro;
+
+
+/*
+ *  Reference formatters, producing the output of the original
+ *  std::ostream implementations, for the functions under test.
+ */
+
+namespace {
+
+std::string reference_zodiac(const double rasc) {
+    ZodiacInfo zInfo;
+    get_zodiac_info(rasc, zInfo);
+
+    std::ostringstream out;
+    out << std::setfill('0') << std::setw(2) << zInfo.degrees
+        << zInfo.sign_short_name << std::setw(2) << zInfo.minutes;
+    return out.str();
+}
+
+std::string reference_rasc(const double rasc) {
+    HMS hms;
+    deg_to_hms(rasc, hms);
+
+    std::ostringstream out;
+    out << std::setfill('0')
+        << std::setw(2) << hms.hours << "h "
+        << std::setw(2) << hms.minutes << "m "
+        << std::setw(2) << hms.seconds << "s";
+    return out.str();
+}
+
+std::string reference_decl(const double decl) {
+    DMS dms;
+    deg_to_dms(decl, dms);
+
+    std::ostringstream out;
+    out << std::setfill('0')
+        << (dms.degrees >= 0 ? "+" : "")
+        << std::setw(2) << dms.degrees << "d "
+        << std::setw(2) << std::fabs(dms.minutes) << "m "
+        << std::setw(2) << std::fabs(dms.seconds) << "s";
+    return out.str();
+}
+
+std::string reference_distance(const double distance) {
+    std::ostringstream out;
+    out.precision(7);
+    out.setf(out.fixed);
+    out << std::setw(10) << distance;
+    return out.str();
+}
+
+std::string reference_row(const BodyId body, const BodyPosition& pos) {
+    ZodiacInfo zInfo;
+    get_zodiac_info(pos.right_ascension, zInfo);
+
+    std::ostringstream out;
+    out << std::left << std::setw(8) << body_name(body) << std::right
+        << ": " << reference_rasc(pos.right_ascension)
+        << ", " << reference_decl(pos.declination)
+        << ", " << reference_distance(pos.distance)
+        << " " << reference_zodiac(pos.right_ascension)
+        << " " << zInfo.sign_name << "\n";
+    return out.str();
+}
+
+}           //  namespace
+
+
+TEST_GROUP(FormattingGroup) {
+};
+
+
+/*
+ *  Tests char buffer versions of rasc_to_zodiac(), rasc_string()
+ *  and decl_string() against known values.
+ */
+
+TEST(FormattingGroup, BufferKnownValuesTest) {
+    char zbuf[ZODIAC_STRING_SIZE];
+    char rbuf[RASC_STRING_SIZE];
+    char dbuf[DECL_STRING_SIZE];
+
+    CHECK_EQUAL(6, rasc_to_zodiac(145.7, zbuf));
+    STRCMP_EQUAL("25LE42", zbuf);
+
+    CHECK_EQUAL(11, rasc_string(182.625, rbuf));
+    STRCMP_EQUAL("12h 10m 30s", rbuf);
+
+    CHECK_EQUAL(12, decl_string(12.175, dbuf));
+    STRCMP_EQUAL("+12d 10m 30s", dbuf);
+
+    CHECK_EQUAL(11, decl_string(-5.5, dbuf));
+    STRCMP_EQUAL("-5d 30m 00s", dbuf);
+}
+
+
+/*
+ *  Tests the char buffer and std::string versions against the
+ *  reference formatters across a range of angles, and at angles
+ *  half-way between whole seconds of time and of arc.
+ */
+
+TEST(FormattingGroup, BufferMatchesReferenceTest) {
+    char zbuf[ZODIAC_STRING_SIZE];
+    char rbuf[RASC_STRING_SIZE];
+    char dbuf[DECL_STRING_SIZE];
+
+    for ( int i = -2000; i <= 2000; ++i ) {
+        const double angle = i * 0.1837;
+        const double half_secs = (i * 37 + 0.5) / 240.0;
+        const double half_arcsecs = (i * 163 + 0.5) / 3600.0;
+        const double angles[] = {angle, half_secs, half_arcsecs};
+
+        for ( size_t j = 0; j < sizeof(angles) / sizeof(angles[0]); ++j ) {
+            const double a = angles[j];
+            const std::string zodiac = reference_zodiac(a);
+            const std::string rasc = reference_rasc(a);
+            const std::string decl = reference_decl(a / 4);
+
+            const size_t zlen = rasc_to_zodiac(a, zbuf);
+            CHECK_EQUAL(zodiac, std::string(zbuf, zlen));
+            CHECK_EQUAL(zodiac, rasc_to_zodiac(a));
+
+            const size_t rlen = rasc_string(a, rbuf);
+            CHECK_EQUAL(rasc, std::string(rbuf, rlen));
+            CHECK_EQUAL(rasc, rasc_string(a));
+
+            const size_t dlen = decl_string(a / 4, dbuf);
+            CHECK_EQUAL(decl, std::string(dbuf, dlen));
+            CHECK_EQUAL(decl, decl_string(a / 4));
+        }
+    }
+}
+
+
+/*
+ *  Tests format_position_row() against the reference formatters,
+ *  with distances including values half-way between the last
+ *  decimal places shown, which must round as std::ostream does.
+ */
+
+TEST(FormattingGroup, PositionRowMatchesReferenceTest) {
+    const double distances[] = {0.0, 1.0, 0.00390625, 0.01171875,
+                                1.00000005, 0.12345675, 2.50000015,
+                                63.99999995, 99.99999995, 1234.5678901,
+                                -0.00000001, -1.00000005};
+    char row[POSITION_ROW_SIZE];
+
+    for ( int i = -500; i <= 500; ++i ) {
+        BodyPosition pos;
+        pos.right_ascension = std::fmod(i * 0.7237 + 360.0, 360.0);
+        pos.declination = i * 0.1793 / 4;
+        pos.distance = i * 0.0123456789 + 40.0;
+
+        const BodyId body = static_cast<BodyId>((i + 500) % NUM_BODIES);
+        const size_t length = format_position_row(body, pos, row);
+        CHECK_EQUAL(reference_row(body, pos), std::string(row, length));
+    }
+
+    for ( size_t i = 0; i < sizeof(distances) / sizeof(distances[0]); ++i ) {
+        BodyPosition pos;
+        pos.right_ascension = 145.7;
+        pos.declination = -12.175;
+        pos.distance = distances[i];
+
+        const size_t length = format_position_row(BODY_MARS, pos, row);
+        CHECK_EQUAL(reference_row(BODY_MARS, pos), std::string(row, length));
+    }
+}
+
+
+/*
+ *  Tests format_position_row() function.
+ */
+
+TEST(FormattingGroup, PositionRowTest) {
+    BodyPosition pos;
+    pos.right_ascension = 145.7;
+    pos.declination = -12.175;
+    pos.distance = 1.23456789;
+
+    char row[POSITION_ROW_SIZE];
+    const size_t length = format_position_row(BODY_MARS, pos, row);
+
+    const std::string expected =
+        "Mars    : 09h 42m 48s, -12d 10m 30s,  1.2345679 25LE42 Leo\n";
+    CHECK_EQUAL(expected.size(), length);
+    CHECK_EQUAL(expected, std::string(row));
+}
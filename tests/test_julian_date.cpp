@@ -21,8 +21,13 @@
 
 #include <CppUTest/CommandLineTestRunner.h>
 #include <ctime>
+#include <string>
+#include <stdint.h>
 #include <paulgrif/utctime.h>
 #include "../astrofunc.h"
+#include "../julian_date.h"
+#include "../planets.h"
+#include "../moon.h"
 
 using namespace astro;
 
@@ -65,3 +70,63 @@ TEST(JulianDateGroup, ThirdDateTest) {
 
     DOUBLES_EQUAL(2421908.9661, jdate, accuracy);
 }
+
+
+/*
+ *  Tests conversion from Unix time, including times before the
+ *  Unix epoch.
+ */
+
+TEST(JulianDateGroup, FromUnixTest) {
+    const utctime::UTCTime ct(2013, 6, 2, 15, 30, 27);
+    const JulianDate jdate = julian_date_from_unix(ct.timestamp());
+    DOUBLES_EQUAL(2456445.5, jdate.day, 1e-9);
+    DOUBLES_EQUAL((15 * 3600 + 30 * 60 + 27) / 86400.0, jdate.fraction,
+                  1e-15);
+    DOUBLES_EQUAL(julian_date(ct), jdate.value(), 1e-9);
+    DOUBLES_EQUAL(julian_centuries(ct), jdate.centuries(), 1e-14);
+
+    const JulianDate before = julian_date_from_unix(-86400 - 21600);
+    DOUBLES_EQUAL(2440585.5, before.day, 1e-9);
+    DOUBLES_EQUAL(0.75, before.fraction, 1e-15);
+
+    const int64_t secs[] = {-1000000000, 0, 1, 1370187027, 4102444800};
+    double jdates[5];
+    julian_dates_from_unix(secs, 5, jdates);
+    for ( int i = 0; i < 5; ++i ) {
+        DOUBLES_EQUAL(julian_date_from_unix(secs[i]).value(), jdates[i],
+                      1e-9);
+    }
+}
+
+
+/*
+ *  Tests planets constructed from a Julian date agree with those
+ *  constructed from a UTCTime.
+ */
+
+TEST(JulianDateGroup, PlanetConstructorTest) {
+    const utctime::UTCTime ct(2013, 6, 2, 15, 30, 27);
+    const JulianDate jdate = julian_date_from_unix(ct.timestamp());
+
+    const Mars mars_utc(ct);
+    const Mars mars_jd(jdate);
+    CHECK_EQUAL(mars_utc.right_ascension(), mars_jd.right_ascension());
+    CHECK_EQUAL(mars_utc.declination(), mars_jd.declination());
+
+    const Moon moon_utc(ct);
+    const Moon moon_jd(jdate);
+    CHECK_EQUAL(moon_utc.right_ascension(), moon_jd.right_ascension());
+
+    //  A Julian date as a single double differs only by rounding.
+
+    const Mars mars_double(JulianDate(julian_date(ct)));
+    DOUBLES_EQUAL(mars_utc.right_ascension(),
+                  mars_double.right_ascension(), 1e-8);
+
+    CHECK_EQUAL(ct.time_string(), mars_jd.calc_time_string());
+    CHECK_EQUAL(ct.time_string(), mars_utc.calc_time_string());
+    CHECK_EQUAL(ct.timestamp(), mars_jd.get_calc_time().timestamp());
+    CHECK_EQUAL(ct.timestamp(), mars_double.get_calc_time().timestamp());
+    CHECK_EQUAL(ct.timestamp(), unix_seconds(jdate));
+}
@@ -64,3 +64,60 @@ TEST(KeplerGroup, KeplerTest) {
     test_result = kepler(radians(45), 0.9);
     DOUBLES_EQUAL(expected_result, test_result, accuracy);
 }
+
+
+/*
+ *  Tests kepler_batch() function gives the same results as kepler(),
+ *  including for a number of equations which is not a multiple of
+ *  the internal block size.
+ */
+
+TEST(KeplerGroup, KeplerBatchTest) {
+    const double accuracy = 0.00001;
+    const double m_anom[] = {radians(20), radians(27), radians(235),
+                             radians(0), radians(360), radians(300),
+                             radians(45)};
+    const double ecc[] = {0.5, 0.5, 0.2, 0, 0, 0, 0.9};
+    const size_t count = sizeof(m_anom) / sizeof(m_anom[0]);
+    double e_anom[count];
+
+    kepler_batch(m_anom, ecc, e_anom, count);
+
+    for ( size_t i = 0; i < count; ++i ) {
+        DOUBLES_EQUAL(kepler(m_anom[i], ecc[i]), e_anom[i], accuracy);
+    }
+}
+
+
+/*
+ *  Tests kepler() function with specified accuracy, including
+ *  high eccentricities and mean anomalies outside of -pi to pi.
+ */
+
+TEST(KeplerGroup, KeplerAccuracyTest) {
+    int iterations;
+
+    double test_result = kepler(radians(45), 0.9, 1e-12, 50, iterations);
+    DOUBLES_EQUAL(radians(96.25884), test_result, 0.00001);
+    CHECK(iterations > 0);
+    CHECK(iterations < 10);
+
+    test_result = kepler(radians(720 + 235), 0.2, 1e-12, 50, iterations);
+    DOUBLES_EQUAL(radians(720 + 226.66512), test_result, 0.00001);
+
+    test_result = kepler(radians(-125), 0.2, 1e-12, 50, iterations);
+    DOUBLES_EQUAL(radians(226.66512 - 360), test_result, 0.00001);
+
+    //  Iteration count is capped, and a looser accuracy
+    //  should need no more iterations than a tighter one.
+
+    test_result = kepler(radians(1), 0.99, 1e-12, 2, iterations);
+    LONGS_EQUAL(2, iterations);
+
+    int loose_iterations;
+    kepler(radians(1), 0.99, 1e-3, 50, loose_iterations);
+    test_result = kepler(radians(1), 0.99, 1e-12, 50, iterations);
+    CHECK(loose_iterations <= iterations);
+    DOUBLES_EQUAL(radians(1),
+                  test_result - 0.99 * std::sin(test_result), 1e-12);
+}
@@ -20,6 +20,7 @@
 
 
 #include <CppUTest/CommandLineTestRunner.h>
+#include <vector>
 #include <paulgrif/utctime.h>
 #include "../astro.h"
 
@@ -55,3 +56,121 @@ TEST(MoonGroup, MoonTest) {
     test_result = normalize_degrees(cds.declination);
     DOUBLES_EQUAL(expected_result, test_result, de_accuracy);
 }
+
+
+/*
+ *  Tests state() for the Moon, with the position checked against
+ *  geo_ecl_coords() and the velocity checked against positions a
+ *  minute either side.
+ */
+
+TEST(MoonGroup, MoonStateTest) {
+    const double minute = 1.0 / 1440;
+    const double accuracy = 1e-5;
+
+    for ( int day = 1; day <= 28; day += 3 ) {
+        const Moon before(utctime::UTCTime(2005, 7, day, 5, 59, 0));
+        const Moon now(utctime::UTCTime(2005, 7, day, 6, 0, 0));
+        const Moon after(utctime::UTCTime(2005, 7, day, 6, 1, 0));
+
+        const StateVector ges = now.state();
+        const RectCoords gec = now.geo_ecl_coords();
+        DOUBLES_EQUAL(gec.x, ges.position.x, 1e-10);
+        DOUBLES_EQUAL(gec.y, ges.position.y, 1e-10);
+        DOUBLES_EQUAL(gec.z, ges.position.z, 1e-10);
+
+        const RectCoords p0 = before.geo_ecl_coords();
+        const RectCoords p2 = after.geo_ecl_coords();
+        DOUBLES_EQUAL((p2.x - p0.x) / (2 * minute), ges.velocity.x, accuracy);
+        DOUBLES_EQUAL((p2.y - p0.y) / (2 * minute), ges.velocity.y, accuracy);
+        DOUBLES_EQUAL((p2.z - p0.z) / (2 * minute), ges.velocity.z, accuracy);
+    }
+}
+
+
+/*
+ *  Tests positions and velocities of the Moon against values
+ *  calculated by summing each perturbation term with its own sine
+ *  or cosine, before the terms were evaluated by recurrence.
+ */
+
+TEST(MoonGroup, MoonPerturbationTest) {
+    const double expected[][7] = {
+        {2451545, -45.611306116431074, -43.167547401035471,
+         5.6966579226084937, 8.7375426895705086, -9.9000598895648562,
+         -0.14040634349206649},
+        {2456445.8, 60.675872083913298, 0.27338720854672366,
+         4.0113251940099177, 0.76632749940971734, 13.608474562225096,
+         -0.80379946661282164},
+        {2460000.25, 48.699380156047489, 34.426443264131692,
+         -0.034152735427614898, -7.215304964882562, 11.923041197679874,
+         1.2328751578962007},
+        {2440000.5, 56.587343770034273, 28.547737384470864,
+         0.85497526039884242, -5.6895905378071756, 11.844645414331481,
+         1.1812572059114168}
+    };
+    const double accuracy = 1e-10;
+
+    for ( size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); ++i ) {
+        const StateVector ges = Moon(JulianDate(expected[i][0])).state();
+        DOUBLES_EQUAL(expected[i][1], ges.position.x, accuracy);
+        DOUBLES_EQUAL(expected[i][2], ges.position.y, accuracy);
+        DOUBLES_EQUAL(expected[i][3], ges.position.z, accuracy);
+        DOUBLES_EQUAL(expected[i][4], ges.velocity.x, accuracy);
+        DOUBLES_EQUAL(expected[i][5], ges.velocity.y, accuracy);
+        DOUBLES_EQUAL(expected[i][6], ges.velocity.z, accuracy);
+    }
+}
+
+
+/*
+ *  Tests moon_geo_ecl_coords() is identical to the Moon class, over
+ *  more times than fit in one block.
+ */
+
+TEST(MoonGroup, MoonBatchTest) {
+    const size_t count = 150;
+    std::vector<double> jdates(count);
+    for ( size_t i = 0; i < count; ++i ) {
+        jdates[i] = 2456293.5 + i * 0.37;
+    }
+
+    std::vector<RectCoords> gec(count), gev(count), gec_only(count);
+    moon_geo_ecl_coords(&jdates[0], count, &gec[0], &gev[0]);
+    moon_geo_ecl_coords(&jdates[0], count, &gec_only[0], 0);
+
+    for ( size_t i = 0; i < count; ++i ) {
+        const StateVector ges = Moon(JulianDate(jdates[i])).state();
+        CHECK_EQUAL(ges.position.x, gec[i].x);
+        CHECK_EQUAL(ges.position.y, gec[i].y);
+        CHECK_EQUAL(ges.position.z, gec[i].z);
+        CHECK_EQUAL(ges.velocity.x, gev[i].x);
+        CHECK_EQUAL(ges.velocity.y, gev[i].y);
+        CHECK_EQUAL(ges.velocity.z, gev[i].z);
+        CHECK_EQUAL(gec[i].x, gec_only[i].x);
+        CHECK_EQUAL(gec[i].z, gec_only[i].z);
+    }
+}
+
+
+/*
+ *  Tests the single time moon_geo_ecl_coords() is identical to the
+ *  Moon class, for a Julian date with a separate day and fraction.
+ */
+
+TEST(MoonGroup, MoonSingleTest) {
+    const JulianDate jdate(2456293.5, 0.6180339887);
+    const StateVector ges = Moon(jdate).state();
+
+    RectCoords gec, gev, gec_only;
+    moon_geo_ecl_coords(jdate, gec, &gev);
+    moon_geo_ecl_coords(jdate, gec_only, 0);
+
+    CHECK_EQUAL(ges.position.x, gec.x);
+    CHECK_EQUAL(ges.position.y, gec.y);
+    CHECK_EQUAL(ges.position.z, gec.z);
+    CHECK_EQUAL(ges.velocity.x, gev.x);
+    CHECK_EQUAL(ges.velocity.y, gev.y);
+    CHECK_EQUAL(ges.velocity.z, gev.z);
+    CHECK_EQUAL(gec.y, gec_only.y);
+}
@@ -0,0 +1,142 @@
+/*
+ *  test_observer.cpp
+ *  =================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for Observer and topocentric positions.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <cmath>
+#include "../astro_common_types.h"
+#include "../astrofunc.h"
+#include "../julian_date.h"
+#include "../body_state.h"
+#include "../observer.h"
+
+using namespace astro;
+
+
+TEST_GROUP(ObserverGroup) {
+};
+
+
+/*
+ *  Tests the observer's geocentric position.
+ */
+
+TEST(ObserverGroup, ConstructorTest) {
+    const Observer equator(0, 10);
+    DOUBLES_EQUAL(1, equator.rho_cos_phi, 1e-15);
+    DOUBLES_EQUAL(0, equator.rho_sin_phi, 1e-15);
+    DOUBLES_EQUAL(sin(radians(10)), equator.sin_lon, 1e-15);
+
+    const Observer pole(90, 0, 6378.14);
+    DOUBLES_EQUAL(0, pole.rho_cos_phi, 1e-15);
+    DOUBLES_EQUAL(1 - EARTH_FLATTENING + 0.001, pole.rho_sin_phi, 1e-15);
+
+    //  Palomar, from Meeus, Astronomical Algorithms, Example 11.a
+
+    const Observer palomar(33.356111, -116.8625, 1706);
+    DOUBLES_EQUAL(0.546861, palomar.rho_sin_phi, 1e-6);
+    DOUBLES_EQUAL(0.836339, palomar.rho_cos_phi, 1e-6);
+}
+
+
+/*
+ *  Tests an observer directly beneath the Moon sees it at the zenith,
+ *  about one Earth radius closer than the centre of the Earth does,
+ *  and an observer with the Moon on the horizon sees it lowered by
+ *  the horizontal parallax.
+ */
+
+TEST(ObserverGroup, MoonParallaxTest) {
+    const JulianDate jdate(2456400.5, 0.2);
+    const Observer origin;
+
+    BodyState state;
+    compute(BODY_MOON, jdate, state);
+    RectCoords gec, gqc;
+    gec.x = state.geo_ecl[0];
+    gec.y = state.geo_ecl[1];
+    gec.z = state.geo_ecl[2];
+    ecl_to_equ(gec, gqc);
+
+    //  The hour angle at longitude zero ignoring parallax gives the
+    //  longitude of the point beneath the Moon.
+
+    TopoCoords geo;
+    topocentric(origin, jdate, gqc, 0, geo);
+    DOUBLES_EQUAL(state.distance, geo.distance, 1e-12);
+
+    const Observer beneath(state.declination, -geo.hour_angle);
+    TopoCoords topo;
+    topocentric(beneath, BODY_MOON, jdate, topo);
+    DOUBLES_EQUAL(90, topo.altitude, 0.2);
+    DOUBLES_EQUAL(state.distance - 1, topo.distance, 0.01);
+    DOUBLES_EQUAL(state.declination, topo.declination, 0.2);
+
+    //  Ninety degrees of longitude away on the equator, the Moon is
+    //  on the geocentric horizon.
+
+    const Observer horizon(0, 90 - geo.hour_angle);
+    TopoCoords geo_horizon;
+    topocentric(horizon, jdate, gqc, 0, geo_horizon);
+    topocentric(horizon, BODY_MOON, jdate, topo);
+    const double parallax =
+        degrees(asin(cos(radians(geo_horizon.altitude)) / state.distance));
+    CHECK(parallax > 0.9 && parallax < 1.0);
+    DOUBLES_EQUAL(geo_horizon.altitude - parallax, topo.altitude, 0.01);
+}
+
+
+/*
+ *  Tests altitude, azimuth and hour angle are consistent with the
+ *  topocentric right ascension and declination, and that the batch
+ *  function gives the same results as single observers.
+ */
+
+TEST(ObserverGroup, BatchTest) {
+    const JulianDate jdate(2456500.5, 0.6);
+    const Observer observers[] = {
+        Observer(51.48, 0), Observer(-33.86, 151.21, 58),
+        Observer(19.82, -155.47, 4205), Observer(78.22, 15.65),
+        Observer(-89.9, 0, 2835)
+    };
+    const size_t count = sizeof(observers) / sizeof(observers[0]);
+
+    for ( int b = BODY_SUN; b < NUM_BODIES; ++b ) {
+        const BodyId body = static_cast<BodyId>(b);
+        TopoCoords batch[count];
+        topocentric(observers, count, body, jdate, batch);
+
+        for ( size_t i = 0; i < count; ++i ) {
+            const Observer& obs = observers[i];
+            TopoCoords topo;
+            topocentric(obs, body, jdate, topo);
+            DOUBLES_EQUAL(topo.right_ascension, batch[i].right_ascension,
+                          1e-12);
+            DOUBLES_EQUAL(topo.altitude, batch[i].altitude, 1e-12);
+            DOUBLES_EQUAL(topo.azimuth, batch[i].azimuth, 1e-12);
+
+            const double dec = radians(topo.declination);
+            const double ha = radians(topo.hour_angle);
+            const double sin_alt = obs.sin_lat * sin(dec) +
+                                   obs.cos_lat * cos(dec) * cos(ha);
+            DOUBLES_EQUAL(sin_alt, sin(radians(topo.altitude)), 1e-12);
+
+            const double az = atan2(-cos(dec) * sin(ha),
+                                    sin(dec) * obs.cos_lat -
+                                    cos(dec) * cos(ha) * obs.sin_lat);
+            DOUBLES_EQUAL(0, remainder(degrees(az) - topo.azimuth, 360),
+                          1e-8);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ *  test_orbit_rotation.cpp
+ *  =======================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for orbital plane to ecliptic rotation matrices.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <cmath>
+#include "../astro_common_types.h"
+#include "../astrofunc.h"
+#include "../orbit_rotation.h"
+#include "../body_time_series.h"
+
+using namespace astro;
+
+
+TEST_GROUP(OrbitRotationGroup) {
+};
+
+
+/*
+ *  Tests the matrix is orthonormal, and gives the same result as
+ *  rotating by each of the angles in turn.
+ */
+
+TEST(OrbitRotationGroup, MatrixTest) {
+    OrbElem oes;
+    oes.arp = radians(-73.5);
+    oes.lan = radians(49.56);
+    oes.inc = radians(1.85);
+
+    RotMatrix rot;
+    orb_to_ecl_matrix(oes, rot);
+
+    const double accuracy = 1e-15;
+    for ( int i = 0; i < 3; ++i ) {
+        for ( int j = 0; j < 3; ++j ) {
+            double dot = 0;
+            for ( int k = 0; k < 3; ++k ) {
+                dot += rot.m[k][i] * rot.m[k][j];
+            }
+            DOUBLES_EQUAL(i == j ? 1 : 0, dot, accuracy);
+        }
+    }
+
+    RectCoords hoc;
+    hoc.x = 1.2;
+    hoc.y = -0.7;
+    RectCoords hec;
+    orb_to_ecl(rot, hoc, hec);
+
+    const double x1 = hoc.x * cos(oes.arp) - hoc.y * sin(oes.arp);
+    const double y1 = hoc.x * sin(oes.arp) + hoc.y * cos(oes.arp);
+    const double y2 = y1 * cos(oes.inc);
+    const double z2 = y1 * sin(oes.inc);
+    DOUBLES_EQUAL(x1 * cos(oes.lan) - y2 * sin(oes.lan), hec.x, accuracy);
+    DOUBLES_EQUAL(x1 * sin(oes.lan) + y2 * cos(oes.lan), hec.y, accuracy);
+    DOUBLES_EQUAL(z2, hec.z, accuracy);
+}
+
+
+/*
+ *  Tests OrbitRotation only recalculates when the angles move
+ *  beyond the tolerance.
+ */
+
+TEST(OrbitRotationGroup, ToleranceTest) {
+    OrbElem oes;
+    oes.arp = 1.0;
+    oes.lan = 2.0;
+    oes.inc = 0.1;
+
+    OrbitRotation exact;
+    OrbitRotation loose(1e-6);
+
+    for ( int i = 0; i < 10; ++i ) {
+        oes.lan = 2.0 + i * 1e-7;
+        exact.update(oes);
+        loose.update(oes);
+    }
+    CHECK_EQUAL(10, exact.recalculations());
+    CHECK_EQUAL(1, loose.recalculations());
+
+    oes.lan = 2.0 + 2e-6;
+    loose.update(oes);
+    CHECK_EQUAL(2, loose.recalculations());
+    DOUBLES_EQUAL(exact.matrix().m[0][0], loose.matrix().m[0][0], 1e-5);
+}
+
+
+/*
+ *  Tests BodyTimeSeries results with a rotation tolerance stay
+ *  close to the exact results.
+ */
+
+TEST(OrbitRotationGroup, TimeSeriesToleranceTest) {
+    const size_t count = 200;
+    double jdates[count];
+    for ( size_t i = 0; i < count; ++i ) {
+        jdates[i] = 2456293.5 + i * 0.05;
+    }
+
+    RectCoords exact[count];
+    RectCoords loose[count];
+    BodyTimeSeries(BODY_JUPITER).geo_equ_coords(jdates, count, exact);
+    BodyTimeSeries(BODY_JUPITER, 1e-8).geo_equ_coords(jdates, count, loose);
+
+    //  Jupiter is within about 6.5 AU of the Earth, and the tolerance
+    //  applies to three angles for each of Jupiter and the Earth.
+
+    const double accuracy = 6.5 * 6e-8;
+    for ( size_t i = 0; i < count; ++i ) {
+        DOUBLES_EQUAL(exact[i].x, loose[i].x, accuracy);
+        DOUBLES_EQUAL(exact[i].y, loose[i].y, accuracy);
+        DOUBLES_EQUAL(exact[i].z, loose[i].z, accuracy);
+    }
+}
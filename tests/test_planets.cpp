@@ -280,3 +280,73 @@ TEST(PlanetsGroup, SunTest) {
     test_result = cds.distance;
     DOUBLES_EQUAL(expected_result, test_result, di_accuracy);
 }
+
+
+/*
+ *  Tests that the cached spherical coordinates match those calculated
+ *  directly, for Mars on June 21, 1997, 00:00 UTC.
+ */
+
+TEST(PlanetsGroup, SphericalTest) {
+    SphCoords cds;
+    const double accuracy = 0.0000001;
+
+    Mars mars(utctime::UTCTime(1997, 6, 21, 0, 0, 0));
+    rec_to_sph(mars.geo_equ_coords(), cds);
+
+    for ( int i = 0; i < 2; ++i ) {
+        DOUBLES_EQUAL(cds.right_ascension, mars.right_ascension(), accuracy);
+        DOUBLES_EQUAL(cds.declination, mars.declination(), accuracy);
+        DOUBLES_EQUAL(cds.distance, mars.distance(), accuracy);
+    }
+
+    const SphCoords& sph = mars.spherical();
+    DOUBLES_EQUAL(cds.right_ascension, sph.right_ascension, accuracy);
+    DOUBLES_EQUAL(cds.declination, sph.declination, accuracy);
+    DOUBLES_EQUAL(cds.distance, sph.distance, accuracy);
+}
+
+
+/*
+ *  Tests state() for the Sun, Venus and Saturn, with the position
+ *  checked against geo_ecl_coords() and the velocity checked against
+ *  positions a minute either side.
+ */
+
+TEST(PlanetsGroup, StateTest) {
+    const double minute = 1.0 / 1440;
+    const double accuracy = 1e-7;
+
+    const utctime::UTCTime before(1994, 2, 14, 11, 59, 0);
+    const utctime::UTCTime now(1994, 2, 14, 12, 0, 0);
+    const utctime::UTCTime after(1994, 2, 14, 12, 1, 0);
+
+    const Sun sun[] = {Sun(before), Sun(now), Sun(after)};
+    const Venus venus[] = {Venus(before), Venus(now), Venus(after)};
+    const Saturn saturn[] = {Saturn(before), Saturn(now), Saturn(after)};
+    const MajorBody * const bodies[][3] = {
+        {&sun[0], &sun[1], &sun[2]},
+        {&venus[0], &venus[1], &venus[2]},
+        {&saturn[0], &saturn[1], &saturn[2]}
+    };
+
+    for ( int b = 0; b < 3; ++b ) {
+        const StateVector ges = bodies[b][1]->state();
+        const RectCoords gec = bodies[b][1]->geo_ecl_coords();
+        DOUBLES_EQUAL(gec.x, ges.position.x, 1e-12);
+        DOUBLES_EQUAL(gec.y, ges.position.y, 1e-12);
+        DOUBLES_EQUAL(gec.z, ges.position.z, 1e-12);
+
+        const RectCoords p0 = bodies[b][0]->geo_ecl_coords();
+        const RectCoords p2 = bodies[b][2]->geo_ecl_coords();
+        DOUBLES_EQUAL((p2.x - p0.x) / (2 * minute), ges.velocity.x, accuracy);
+        DOUBLES_EQUAL((p2.y - p0.y) / (2 * minute), ges.velocity.y, accuracy);
+        DOUBLES_EQUAL((p2.z - p0.z) / (2 * minute), ges.velocity.z, accuracy);
+    }
+
+    //  The Earth's geocentric state is always zero
+
+    const StateVector ees = Earth(now).state();
+    DOUBLES_EQUAL(0, ees.position.x, 0);
+    DOUBLES_EQUAL(0, ees.velocity.x, 0);
+}
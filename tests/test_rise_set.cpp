@@ -0,0 +1,142 @@
+/*
+ *  test_rise_set.cpp
+ *  =================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for rise, transit and set time calculations.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <cmath>
+#include "../astro_common_types.h"
+#include "../astrofunc.h"
+#include "../julian_date.h"
+#include "../observer.h"
+#include "../rise_set.h"
+
+using namespace astro;
+
+
+TEST_GROUP(RiseSetGroup) {
+};
+
+
+/*
+ *  Tests against Meeus, Astronomical Algorithms, Example 15.a, for
+ *  Venus at Boston on 1988 March 20. Times agree to within a couple
+ *  of minutes, since positions are referred to the J2000 equator.
+ */
+
+TEST(RiseSetGroup, VenusTest) {
+    const Observer boston(42.3333, -71.0833);
+    const JulianDate day_start(2447240.5);
+    const double accuracy = 0.002;
+
+    RiseTransitSet rts;
+    rise_transit_set(BODY_VENUS, boston, day_start, rts);
+
+    CHECK_EQUAL(BODY_VENUS, rts.body);
+    CHECK(rts.has_rise && rts.has_transit && rts.has_set);
+    CHECK(!rts.always_above && !rts.always_below);
+    DOUBLES_EQUAL(2447240.5 + 0.51766, rts.rise, accuracy);
+    DOUBLES_EQUAL(2447240.5 + 0.81980, rts.transit, accuracy);
+    DOUBLES_EQUAL(2447240.5 + 0.12130, rts.set, accuracy);
+}
+
+
+/*
+ *  Tests sunrise, sunset and twilight at London on the summer
+ *  solstice, when astronomical twilight lasts all night, and at the
+ *  North Pole on the winter solstice, when the Sun never rises.
+ */
+
+TEST(RiseSetGroup, SunTest) {
+    const Observer london(51.5074, -0.1278);
+    const JulianDate day_start(2456464.5);
+    const double accuracy = 0.002;
+
+    RiseTransitSet sun;
+    rise_transit_set(BODY_SUN, london, day_start, sun);
+    CHECK(sun.has_rise && sun.has_transit && sun.has_set);
+    DOUBLES_EQUAL(2456464.5 + (3 + 43.0 / 60) / 24, sun.rise, accuracy);
+    DOUBLES_EQUAL(2456464.5 + (12 + 2.3 / 60) / 24, sun.transit,
+                  accuracy);
+    DOUBLES_EQUAL(2456464.5 + (20 + 21.0 / 60) / 24, sun.set, accuracy);
+
+    RiseTransitSet civil;
+    sun_twilight(london, day_start, TWILIGHT_CIVIL, civil);
+    CHECK(civil.has_rise && civil.has_set);
+    CHECK(civil.rise < sun.rise);
+    CHECK(civil.set > sun.set);
+    DOUBLES_EQUAL(sun.transit, civil.transit, 1e-9);
+
+    TopoCoords topo;
+    topocentric(london, BODY_SUN, JulianDate(civil.rise), topo);
+    DOUBLES_EQUAL(CIVIL_TWILIGHT_ALTITUDE, topo.altitude, 0.001);
+
+    RiseTransitSet astronomical;
+    sun_twilight(london, day_start, TWILIGHT_ASTRONOMICAL, astronomical);
+    CHECK(!astronomical.has_rise && !astronomical.has_set);
+    CHECK(astronomical.always_above);
+    CHECK(astronomical.has_transit);
+
+    const Observer pole(89.99, 0);
+    RiseTransitSet polar;
+    rise_transit_set(BODY_SUN, pole, JulianDate(2456647.5), polar);
+    CHECK(!polar.has_rise && !polar.has_set);
+    CHECK(polar.always_below);
+    CHECK(!polar.always_above);
+}
+
+
+/*
+ *  Tests the Moon's upper limb is on the horizon at moonrise and
+ *  moonset, allowing for refraction and parallax.
+ */
+
+TEST(RiseSetGroup, MoonTest) {
+    const Observer sydney(-33.86, 151.21);
+    int rises = 0;
+    int sets = 0;
+
+    for ( int day = 0; day < 30; ++day ) {
+        RiseTransitSet rts;
+        rise_transit_set(BODY_MOON, sydney, JulianDate(2456600.5 + day),
+                         rts);
+
+        if ( rts.has_rise ) {
+            TopoCoords topo;
+            topocentric(sydney, BODY_MOON, JulianDate(rts.rise), topo);
+            const double limb = degrees(asin(0.2725 / topo.distance));
+            DOUBLES_EQUAL(RISE_SET_ALTITUDE - limb, topo.altitude, 0.01);
+            ++rises;
+        }
+
+        if ( rts.has_set ) {
+            TopoCoords topo;
+            topocentric(sydney, BODY_MOON, JulianDate(rts.set), topo);
+            const double limb = degrees(asin(0.2725 / topo.distance));
+            DOUBLES_EQUAL(RISE_SET_ALTITUDE - limb, topo.altitude, 0.01);
+            ++sets;
+        }
+
+        if ( rts.has_transit ) {
+            TopoCoords topo;
+            topocentric(sydney, BODY_MOON, JulianDate(rts.transit), topo);
+            DOUBLES_EQUAL(0, topo.hour_angle, 0.01);
+        }
+    }
+
+    //  The Moon rises about 50 minutes later each day, so misses one
+    //  rising and one setting a month.
+
+    CHECK(rises >= 28 && rises <= 30);
+    CHECK(sets >= 28 && sets <= 30);
+}
@@ -0,0 +1,104 @@
+/*
+ *  test_sidereal.cpp
+ *  =================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for sidereal time and hour angle functions.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <stdint.h>
+#include "../astrofunc.h"
+#include "../julian_date.h"
+#include "../sidereal.h"
+
+using namespace astro;
+
+
+TEST_GROUP(SiderealGroup) {
+};
+
+
+/*
+ *  Tests sidereal times against Meeus, Astronomical Algorithms,
+ *  Examples 12.a and 12.b.
+ */
+
+TEST(SiderealGroup, GMSTTest) {
+    const double accuracy = 1e-6;
+
+    DOUBLES_EQUAL(197.693195, gmst(JulianDate(2446895.5)), accuracy);
+    DOUBLES_EQUAL(128.7378734, gmst(JulianDate(2446895.5, 0.80625)),
+                  accuracy);
+    DOUBLES_EQUAL(128.7378734, gmst(JulianDate(2446896.30625)),
+                  accuracy);
+    DOUBLES_EQUAL(normalize_degrees(128.7378734 - 77.065),
+                  lst(JulianDate(2446895.5, 0.80625), -77.065), accuracy);
+    DOUBLES_EQUAL(280.46061837, gmst(JulianDate()), 1e-9);
+}
+
+
+/*
+ *  Tests the array and incremental functions agree with gmst().
+ */
+
+TEST(SiderealGroup, BatchTest) {
+    const int64_t secs[] = {-86399, 0, 546120060, 946728000,
+                            1381017600, 4102444799LL};
+    const size_t count = sizeof(secs) / sizeof(secs[0]);
+    double gmsts[count];
+    gmst_from_unix(secs, count, gmsts);
+
+    for ( size_t i = 0; i < count; ++i ) {
+        DOUBLES_EQUAL(gmst(julian_date_from_unix(secs[i])), gmsts[i], 0);
+    }
+
+    const JulianDate start(2456566.5, 0.1);
+    const size_t samples = 1441;
+    const double step = 1.0 / 1440;
+    double uniform[samples];
+    gmst_uniform(start, step, samples, uniform);
+
+    for ( size_t i = 0; i < samples; i += 60 ) {
+        const double expected = gmst(JulianDate(start.day,
+                                                start.fraction + i * step));
+        DOUBLES_EQUAL(0, remainder(expected - uniform[i], 360), 1e-9);
+    }
+
+    const JulianDate year_start(2456293.5);
+    double daily[366];
+    gmst_uniform(year_start, 1, 366, daily);
+    DOUBLES_EQUAL(0, remainder(gmst(JulianDate(2456658.5)) - daily[365],
+                               360), 1e-7);
+}
+
+
+/*
+ *  Tests hour angles are reduced to -180 < ha <= 180.
+ */
+
+TEST(SiderealGroup, HourAnglesTest) {
+    const double gmsts[] = {10, 350, 100, 0, 180};
+    const double rasc[] = {20, 10, 280, 180, 0};
+    double has[5];
+    hour_angles(gmsts, rasc, 5, 15, has);
+
+    DOUBLES_EQUAL(5, has[0], 1e-12);
+    DOUBLES_EQUAL(-5, has[1], 1e-12);
+    DOUBLES_EQUAL(-165, has[2], 1e-12);
+    DOUBLES_EQUAL(-165, has[3], 1e-12);
+    DOUBLES_EQUAL(-165, has[4], 1e-12);
+
+    const double edge_gmst = 180;
+    const double edge_rasc = 0;
+    double edge;
+    hour_angles(&edge_gmst, &edge_rasc, 1, 0, &edge);
+    DOUBLES_EQUAL(180, edge, 0);
+}
@@ -0,0 +1,74 @@
+/*
+ *  test_solar_system.cpp
+ *  =====================
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for solar_system_snapshot() function.
+ *
+ *  The snapshot should give the same results as calculating each
+ *  planet individually.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <paulgrif/utctime.h>
+#include "../astro.h"
+
+using namespace astro;
+
+
+TEST_GROUP(SolarSystemGroup) {
+};
+
+
+/*
+ *  Tests snapshot positions against individual planets for
+ *  May 5, 1980, 20:23 UTC.
+ */
+
+TEST(SolarSystemGroup, SnapshotTest) {
+    const double accuracy = 0.0000001;
+    const utctime::UTCTime utc(1980, 5, 5, 20, 23, 0);
+
+    SolarSystemSnapshot snap;
+    solar_system_snapshot(utc, snap);
+
+    const Sun sun(utc);
+    const Mercury mercury(utc);
+    const Venus venus(utc);
+    const Mars mars(utc);
+    const Jupiter jupiter(utc);
+    const Saturn saturn(utc);
+    const Uranus uranus(utc);
+    const Neptune neptune(utc);
+    const Pluto pluto(utc);
+    const Moon moon(utc);
+
+    const Planet* planets[] = {&sun, &mercury, &venus,
+                               &mars, &jupiter, &saturn,
+                               &uranus, &neptune, &pluto, &moon};
+
+    DOUBLES_EQUAL(julian_date(utc), snap.jdate, accuracy);
+
+    for ( int i = 0; i < NUM_BODIES; ++i ) {
+        const BodyPosition& pos = snap.bodies[i];
+        const RectCoords gec = planets[i]->geo_ecl_coords();
+
+        STRCMP_EQUAL(planets[i]->name().c_str(),
+                     body_name(static_cast<BodyId>(i)));
+        DOUBLES_EQUAL(planets[i]->right_ascension(),
+                      pos.right_ascension, accuracy);
+        DOUBLES_EQUAL(planets[i]->declination(),
+                      pos.declination, accuracy);
+        DOUBLES_EQUAL(planets[i]->distance(), pos.distance, accuracy);
+        DOUBLES_EQUAL(gec.x, pos.geo_ecl.x, accuracy);
+        DOUBLES_EQUAL(gec.y, pos.geo_ecl.y, accuracy);
+        DOUBLES_EQUAL(gec.z, pos.geo_ecl.z, accuracy);
+    }
+}
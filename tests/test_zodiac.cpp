@@ -0,0 +1,91 @@
+/*
+ *  test_zodiac.cpp
+ *  ===============
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Unit tests for bulk zodiac classification functions.
+ *
+ *  Uses CppUTest unit testing framework.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <CppUTest/CommandLineTestRunner.h>
+#include <vector>
+#include <stdint.h>
+#include "../astro_common_types.h"
+#include "../astrofunc.h"
+#include "../zodiac.h"
+
+using namespace astro;
+
+
+TEST_GROUP(ZodiacGroup) {
+};
+
+
+/*
+ *  Tests classify_zodiac() agrees with get_zodiac_info().
+ */
+
+TEST(ZodiacGroup, ClassifyMatchesZodiacInfoTest) {
+    const size_t count = 20001;
+    std::vector<double> rasc(count);
+    for ( size_t i = 0; i < count; ++i ) {
+        rasc[i] = -720 + i * 0.0731;
+    }
+
+    std::vector<uint8_t> signs(count);
+    std::vector<uint16_t> arcmins(count);
+    classify_zodiac(&rasc[0], &signs[0], &arcmins[0], count);
+
+    for ( size_t i = 0; i < count; ++i ) {
+        ZodiacInfo zInfo;
+        get_zodiac_info(rasc[i], zInfo);
+        CHECK_EQUAL(zInfo.sign_index, signs[i]);
+        CHECK_EQUAL(zInfo.degrees * 60 + zInfo.minutes, arcmins[i]);
+    }
+}
+
+
+/*
+ *  Tests zodiac_histogram() function.
+ */
+
+TEST(ZodiacGroup, HistogramTest) {
+    const size_t count = 3600;
+    std::vector<double> rasc(count);
+    for ( size_t i = 0; i < count; ++i ) {
+        rasc[i] = i * 0.1 + 0.05;
+    }
+
+    size_t sign_counts[NUM_ZODIAC_SIGNS];
+    zodiac_histogram(&rasc[0], count, sign_counts);
+
+    for ( int s = 0; s < NUM_ZODIAC_SIGNS; ++s ) {
+        CHECK_EQUAL(300, sign_counts[s]);
+    }
+}
+
+
+/*
+ *  Tests zodiac_ingresses() function.
+ */
+
+TEST(ZodiacGroup, IngressesTest) {
+    const double rasc[] = {25, 29.9, 30.1, 45, 59, 61, 355, 1};
+    const size_t count = sizeof(rasc) / sizeof(rasc[0]);
+
+    uint8_t signs[count];
+    classify_zodiac(rasc, signs, 0, count);
+
+    size_t ingresses[count - 1];
+    CHECK_EQUAL(4, zodiac_ingresses(signs, count, ingresses));
+    CHECK_EQUAL(2, ingresses[0]);
+    CHECK_EQUAL(5, ingresses[1]);
+    CHECK_EQUAL(6, ingresses[2]);
+    CHECK_EQUAL(7, ingresses[3]);
+}
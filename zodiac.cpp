@@ -0,0 +1,143 @@
+/*
+ *  zodiac.cpp
+ *  ==========
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Implementation of bulk zodiac classification functions.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#include <cstddef>
+#include <cassert>
+#include <stdint.h>
+#include "zodiac.h"
+
+using namespace astro;
+
+
+/*
+ *  Local constants
+ */
+
+namespace {
+
+const int arcsecs_in_circle = 360 * 3600;
+const int arcmins_in_sign = 30 * 60;
+
+//  Number of right ascensions classified at a time by
+//  zodiac_histogram()
+
+const size_t histogram_block = 256;
+
+
+/*
+ *  Returns the number of whole minutes of arc, 0 to 21599, of the
+ *  supplied right ascension in degrees after it is normalized to
+ *  0 <= d < 360 and truncated to whole seconds of arc in the same
+ *  way as deg_to_dms() does. Values which round up to a full circle
+ *  wrap back to zero. Integer conversions are used in place of
+ *  floor() so that loops calling this contain no function calls.
+ */
+
+inline int arcmins_in_circle(const double rasc) {
+    const double turns = rasc / 360;
+    const int whole_turns = static_cast<int>(turns) -
+                            (turns < static_cast<int>(turns));
+    const double norm_degs = rasc - 360.0 * whole_turns;
+    const int secs = static_cast<int>(norm_degs * 3600) % arcsecs_in_circle;
+    return secs / 60;
+}
+
+}           //  namespace
+
+
+/*
+ *  Classifies each of the supplied right ascensions, in degrees,
+ *  by zodiac sign. For each right ascension, the index of the sign
+ *  (0 for Aries to 11 for Pisces) is stored in sign_idx, and the
+ *  number of whole minutes of arc into that sign (0 to 1799) is
+ *  stored in arcmin. Either output may be null if it is not needed.
+ *
+ *  The results agree with the sign_index, degrees and minutes
+ *  members set by get_zodiac_info(), but the loop contains no
+ *  branches or function calls, so the compiler is free to vectorize
+ *  it. The right ascensions must be less than about 7e11 degrees
+ *  in magnitude.
+ */
+
+void astro::classify_zodiac(const double * rasc, uint8_t * sign_idx,
+                            uint16_t * arcmin, const size_t count) {
+
+    //  Separate loops avoid testing for null outputs on every
+    //  iteration, which would prevent vectorization.
+
+    if ( sign_idx && arcmin ) {
+        for ( size_t i = 0; i < count; ++i ) {
+            const int mins = arcmins_in_circle(rasc[i]);
+            sign_idx[i] = static_cast<uint8_t>(mins / arcmins_in_sign);
+            arcmin[i] = static_cast<uint16_t>(mins % arcmins_in_sign);
+        }
+    } else if ( sign_idx ) {
+        for ( size_t i = 0; i < count; ++i ) {
+            const int mins = arcmins_in_circle(rasc[i]);
+            sign_idx[i] = static_cast<uint8_t>(mins / arcmins_in_sign);
+        }
+    } else if ( arcmin ) {
+        for ( size_t i = 0; i < count; ++i ) {
+            const int mins = arcmins_in_circle(rasc[i]);
+            arcmin[i] = static_cast<uint16_t>(mins % arcmins_in_sign);
+        }
+    }
+}
+
+
+/*
+ *  Counts the number of the supplied right ascensions falling in
+ *  each zodiac sign. sign_counts must point to an array of
+ *  NUM_ZODIAC_SIGNS elements, which are overwritten.
+ */
+
+void astro::zodiac_histogram(const double * rasc, const size_t count,
+                             size_t * sign_counts) {
+    for ( int s = 0; s < NUM_ZODIAC_SIGNS; ++s ) {
+        sign_counts[s] = 0;
+    }
+
+    uint8_t signs[histogram_block];
+    for ( size_t start = 0; start < count; start += histogram_block ) {
+        const size_t n = count - start < histogram_block ?
+                         count - start : histogram_block;
+
+        classify_zodiac(rasc + start, signs, 0, n);
+        for ( size_t i = 0; i < n; ++i ) {
+            ++sign_counts[signs[i]];
+        }
+    }
+}
+
+
+/*
+ *  Finds the indices of the elements of the supplied array of sign
+ *  indices, as produced by classify_zodiac() for a time series,
+ *  which are in a different sign to the element before them. The
+ *  indices are stored in ingress_idx, which must have space for
+ *  count - 1 elements, and the number found is returned.
+ */
+
+size_t astro::zodiac_ingresses(const uint8_t * sign_idx, const size_t count,
+                               size_t * ingress_idx) {
+    size_t found = 0;
+
+    for ( size_t i = 1; i < count; ++i ) {
+        assert(sign_idx[i] < NUM_ZODIAC_SIGNS);
+
+        ingress_idx[found] = i;
+        found += (sign_idx[i] != sign_idx[i - 1]);
+    }
+
+    return found;
+}
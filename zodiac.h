@@ -0,0 +1,33 @@
+/*
+ *  zodiac.h
+ *  ========
+ *  Copyright 2013 Paul Griffiths
+ *  Email: mail@paulgriffiths.net
+ *
+ *  Interface to bulk zodiac classification functions.
+ *
+ *  Distributed under the terms of the GNU General Public License.
+ *  http://www.gnu.org/licenses/
+ */
+
+
+#ifndef PG_ASTRO_ZODIAC_H
+#define PG_ASTRO_ZODIAC_H
+
+#include <cstddef>
+#include <stdint.h>
+
+namespace astro {
+
+constexpr int NUM_ZODIAC_SIGNS = 12;
+
+void classify_zodiac(const double * rasc, uint8_t * sign_idx,
+                     uint16_t * arcmin, const size_t count);
+void zodiac_histogram(const double * rasc, const size_t count,
+                      size_t * sign_counts);
+size_t zodiac_ingresses(const uint8_t * sign_idx, const size_t count,
+                        size_t * ingress_idx);
+
+}           //  namespace astro
+
+#endif          // PG_ASTRO_ZODIAC_H